@@ -0,0 +1,212 @@
+/*
+ * This file is part of Jerry application server.
+ * Copyright (C) 2020-2022 Sven Lukas
+ *
+ * Jerry is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as
+ * published by the Free Software Foundation, either version 3 of
+ * the License, or (at your option) any later version.
+ *
+ * Jerry is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public
+ * License along with Jerry.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include <openjerry/benchmark/AllocationCounter.h>
+#include <openjerry/benchmark/FakeRequestContext.h>
+#include <openjerry/benchmark/TreeGenerator.h>
+#include <openjerry/engine/http/Context.h>
+#include <openjerry/engine/http/RequestHandler.h>
+#include <openjerry/engine/http/RouteCache.h>
+
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <iostream>
+#include <memory>
+#include <string>
+#include <vector>
+
+namespace {
+void printUsage() {
+	std::cout << "\n";
+	std::cout << "Usage: open-jerry-benchmark [-endpoints <n>] [-hosts <n>] [-depth <n>] [-procedures <n>] [-handlers <n>] [-requests <n>] [-miss-rate <percent>] [-route-cache <size>]\n";
+	std::cout << "  -endpoints <n>\n";
+	std::cout << "    Number of endpoints with an accepting request handler per host. Default is 100.\n";
+	std::cout << "  -hosts <n>\n";
+	std::cout << "    Number of hosts. 0 puts the endpoints directly into the server context. Default is 1.\n";
+	std::cout << "  -depth <n>\n";
+	std::cout << "    Nesting depth of endpoints. Default is 2.\n";
+	std::cout << "  -procedures <n>\n";
+	std::cout << "    Number of procedures in each context. Default is 1.\n";
+	std::cout << "  -handlers <n>\n";
+	std::cout << "    Number of not accepting request handlers in each context. Default is 1.\n";
+	std::cout << "  -requests <n>\n";
+	std::cout << "    Number of measured requests. Default is 1000000.\n";
+	std::cout << "  -miss-rate <percent>\n";
+	std::cout << "    Percentage of requests to a path that is not found. Default is 0.\n";
+	std::cout << "  -route-cache <size>\n";
+	std::cout << "    Size of the route cache. Default is 0 (disabled).\n";
+	std::cout << std::flush;
+}
+
+bool parseArguments(int argc, const char *argv[], openjerry::benchmark::TreeSettings& treeSettings, std::size_t& requests, std::size_t& missRate, std::size_t& routeCacheSize) {
+	for(int i=1; i<argc; ++i) {
+		std::string flag(argv[i]);
+
+		if(i+1 >= argc) {
+			std::cerr << "Missing value for flag " << flag << "\n";
+			return false;
+		}
+
+		std::size_t value;
+		try {
+			value = std::stoul(argv[++i]);
+		}
+		catch(...) {
+			std::cerr << "Invalid value \"" << argv[i] << "\" for flag " << flag << "\n";
+			return false;
+		}
+
+		if(flag == "-endpoints") {
+			treeSettings.endpoints = value;
+		}
+		else if(flag == "-hosts") {
+			treeSettings.hosts = value;
+		}
+		else if(flag == "-depth") {
+			treeSettings.depth = value;
+		}
+		else if(flag == "-procedures") {
+			treeSettings.procedures = value;
+		}
+		else if(flag == "-handlers") {
+			treeSettings.handlers = value;
+		}
+		else if(flag == "-requests") {
+			requests = value;
+		}
+		else if(flag == "-miss-rate") {
+			if(value > 100) {
+				std::cerr << "Invalid value \"" << value << "\" for flag " << flag << "\n";
+				return false;
+			}
+			missRate = value;
+		}
+		else if(flag == "-route-cache") {
+			routeCacheSize = value;
+		}
+		else {
+			std::cerr << "Unknown flag " << flag << "\n";
+			return false;
+		}
+	}
+
+	return true;
+}
+} /* anonymous namespace */
+
+int main(int argc, const char *argv[]) {
+	openjerry::benchmark::TreeSettings treeSettings;
+	std::size_t requests = 1000000;
+	std::size_t missRate = 0;
+	std::size_t routeCacheSize = 0;
+
+	if(!parseArguments(argc, argv, treeSettings, requests, missRate, routeCacheSize)) {
+		printUsage();
+		return -1;
+	}
+
+	/* *********************** *
+	 * build the context tree *
+	 * *********************** */
+	openjerry::engine::http::Context serverContext(nullptr);
+	openjerry::benchmark::TreeGenerator treeGenerator(treeSettings);
+	treeGenerator.generate(serverContext);
+	serverContext.setDispatchRoot();
+	serverContext.initializeContext();
+
+	std::unique_ptr<openjerry::engine::http::RouteCache> routeCache;
+	openjerry::engine::http::RequestHandler requestHandler(serverContext);
+	if(routeCacheSize > 0) {
+		routeCache.reset(new openjerry::engine::http::RouteCache(routeCacheSize));
+		requestHandler.setRouteCache(routeCache.get());
+	}
+
+	/* ************************************************************** *
+	 * create the request contexts before measuring, they are reused *
+	 * ************************************************************** */
+	const std::vector<std::string>& hostNames = treeGenerator.getHostNames();
+	const std::vector<std::string>& paths = treeGenerator.getPaths();
+	const std::size_t requestContextCount = std::min<std::size_t>(requests, 4096);
+
+	std::vector<std::unique_ptr<openjerry::benchmark::FakeRequestContext>> requestContexts;
+	std::uint32_t random = 1;
+	for(std::size_t i = 0; i < requestContextCount; ++i) {
+		random = random * 1103515245 + 12345;
+
+		std::string hostName = hostNames.empty() ? "localhost" : hostNames[i % hostNames.size()];
+		std::string path;
+		if(paths.empty() || (random >> 8) % 100 < missRate) {
+			path = "/missing/" + std::to_string(i);
+		}
+		else {
+			path = paths[(random >> 8) % paths.size()];
+		}
+		requestContexts.emplace_back(new openjerry::benchmark::FakeRequestContext(hostName, "GET", path));
+	}
+
+	/* warm up object pools and route cache */
+	for(auto& requestContext : requestContexts) {
+		requestHandler.accept(*requestContext);
+	}
+
+	/* ******* *
+	 * measure *
+	 * ******* */
+	std::uint64_t allocationsBefore = openjerry::benchmark::AllocationCounter::getAllocations();
+	auto timeBefore = std::chrono::steady_clock::now();
+
+	for(std::size_t i = 0; i < requests; ++i) {
+		requestHandler.accept(*requestContexts[i % requestContextCount]);
+	}
+
+	auto timeAfter = std::chrono::steady_clock::now();
+	std::uint64_t allocationsAfter = openjerry::benchmark::AllocationCounter::getAllocations();
+
+	std::size_t notFound = 0;
+	std::size_t errors = 0;
+	for(const auto& requestContext : requestContexts) {
+		notFound += requestContext->getFakeConnection().getNotFoundResponses();
+		errors += requestContext->getFakeConnection().getErrorResponses();
+	}
+
+	double ns = static_cast<double>(std::chrono::duration_cast<std::chrono::nanoseconds>(timeAfter - timeBefore).count());
+
+	std::cout << "contexts:            " << treeGenerator.getContexts() << "\n";
+	std::cout << "hosts:               " << hostNames.size() << "\n";
+	std::cout << "leaf endpoints:      " << paths.size() << "\n";
+	std::cout << "requests:            " << requests << "\n";
+	std::cout << "404 responses:       " << notFound << " (including warm up)\n";
+	std::cout << "error responses:     " << errors << " (including warm up)\n";
+	if(requests > 0) {
+		std::cout << "ns/request:          " << ns / static_cast<double>(requests) << "\n";
+		std::cout << "allocations/request: " << static_cast<double>(allocationsAfter - allocationsBefore) / static_cast<double>(requests) << "\n";
+	}
+	if(routeCache) {
+		std::cout << "route cache:         " << routeCache->getHits() << " hits, " << routeCache->getMisses() << " misses\n";
+	}
+	std::cout << std::flush;
+
+	/* a measurement of requests failing with an exception says nothing about dispatching */
+	if(errors > 0) {
+		std::cerr << "Benchmark failed, " << errors << " requests have been answered with an error instead of being accepted or not found.\n";
+		return -1;
+	}
+
+	return 0;
+}
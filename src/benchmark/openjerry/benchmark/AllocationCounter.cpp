@@ -0,0 +1,73 @@
+/*
+ * This file is part of Jerry application server.
+ * Copyright (C) 2020-2022 Sven Lukas
+ *
+ * Jerry is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as
+ * published by the Free Software Foundation, either version 3 of
+ * the License, or (at your option) any later version.
+ *
+ * Jerry is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public
+ * License along with Jerry.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include <openjerry/benchmark/AllocationCounter.h>
+
+#include <atomic>
+#include <cstdlib>
+#include <new>
+
+namespace {
+std::atomic<std::uint64_t> allocations{0};
+
+void* allocate(std::size_t size) {
+	allocations.fetch_add(1, std::memory_order_relaxed);
+
+	void* ptr = std::malloc(size == 0 ? 1 : size);
+	if(ptr == nullptr) {
+		throw std::bad_alloc();
+	}
+	return ptr;
+}
+} /* anonymous namespace */
+
+void* operator new(std::size_t size) {
+	return allocate(size);
+}
+
+void* operator new[](std::size_t size) {
+	return allocate(size);
+}
+
+void operator delete(void* ptr) noexcept {
+	std::free(ptr);
+}
+
+void operator delete[](void* ptr) noexcept {
+	std::free(ptr);
+}
+
+void operator delete(void* ptr, std::size_t) noexcept {
+	std::free(ptr);
+}
+
+void operator delete[](void* ptr, std::size_t) noexcept {
+	std::free(ptr);
+}
+
+namespace openjerry {
+namespace benchmark {
+
+
+std::uint64_t AllocationCounter::getAllocations() noexcept {
+	return allocations.load(std::memory_order_relaxed);
+}
+
+
+} /* namespace benchmark */
+} /* namespace openjerry */
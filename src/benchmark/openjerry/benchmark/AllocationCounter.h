@@ -0,0 +1,42 @@
+/*
+ * This file is part of Jerry application server.
+ * Copyright (C) 2020-2022 Sven Lukas
+ *
+ * Jerry is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as
+ * published by the Free Software Foundation, either version 3 of
+ * the License, or (at your option) any later version.
+ *
+ * Jerry is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public
+ * License along with Jerry.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#ifndef OPENJERRY_BENCHMARK_ALLOCATIONCOUNTER_H_
+#define OPENJERRY_BENCHMARK_ALLOCATIONCOUNTER_H_
+
+#include <cstdint>
+
+namespace openjerry {
+namespace benchmark {
+
+
+/* Counts calls of the global operator new. The counter is process wide, so it is
+ * only meaningful while a single thread is running the benchmark.
+ */
+class AllocationCounter {
+public:
+	AllocationCounter() = delete;
+
+	static std::uint64_t getAllocations() noexcept;
+};
+
+
+} /* namespace benchmark */
+} /* namespace openjerry */
+
+#endif /* OPENJERRY_BENCHMARK_ALLOCATIONCOUNTER_H_ */
@@ -0,0 +1,86 @@
+/*
+ * This file is part of Jerry application server.
+ * Copyright (C) 2020-2022 Sven Lukas
+ *
+ * Jerry is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as
+ * published by the Free Software Foundation, either version 3 of
+ * the License, or (at your option) any later version.
+ *
+ * Jerry is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public
+ * License along with Jerry.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include <openjerry/benchmark/FakeRequestContext.h>
+
+#include <map>
+
+namespace openjerry {
+namespace benchmark {
+
+
+bool FakeConnection::send(const esl::com::http::server::Response& response, esl::io::Output) {
+	count(response);
+	return true;
+}
+
+bool FakeConnection::sendFile(const esl::com::http::server::Response& response, const std::string&) {
+	count(response);
+	return true;
+}
+
+std::size_t FakeConnection::getNotFoundResponses() const noexcept {
+	return notFoundResponses;
+}
+
+std::size_t FakeConnection::getErrorResponses() const noexcept {
+	return errorResponses;
+}
+
+void FakeConnection::count(const esl::com::http::server::Response& response) noexcept {
+	if(response.getStatusCode() == 404) {
+		++notFoundResponses;
+	}
+	else {
+		++errorResponses;
+	}
+}
+
+FakeRequestContext::FakeRequestContext(const std::string& hostName, const std::string& method, const std::string& aPath)
+: request("HTTP/1.1", hostName, 80, aPath, method, "127.0.0.1", 50000, std::map<std::string, std::string>()),
+  path(aPath),
+  objectContext(nullptr)
+{ }
+
+esl::com::http::server::Connection& FakeRequestContext::getConnection() const {
+	return connection;
+}
+
+const esl::com::http::server::Request& FakeRequestContext::getRequest() const {
+	return request;
+}
+
+const std::string& FakeRequestContext::getPath() const {
+	return path;
+}
+
+esl::object::Context& FakeRequestContext::getObjectContext() {
+	return objectContext;
+}
+
+const esl::object::Context& FakeRequestContext::getObjectContext() const {
+	return objectContext;
+}
+
+const FakeConnection& FakeRequestContext::getFakeConnection() const noexcept {
+	return connection;
+}
+
+
+} /* namespace benchmark */
+} /* namespace openjerry */
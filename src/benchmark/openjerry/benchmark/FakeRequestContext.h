@@ -0,0 +1,83 @@
+/*
+ * This file is part of Jerry application server.
+ * Copyright (C) 2020-2022 Sven Lukas
+ *
+ * Jerry is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as
+ * published by the Free Software Foundation, either version 3 of
+ * the License, or (at your option) any later version.
+ *
+ * Jerry is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public
+ * License along with Jerry.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#ifndef OPENJERRY_BENCHMARK_FAKEREQUESTCONTEXT_H_
+#define OPENJERRY_BENCHMARK_FAKEREQUESTCONTEXT_H_
+
+#include <openjerry/engine/ObjectContext.h>
+
+#include <esl/com/http/server/Connection.h>
+#include <esl/com/http/server/Request.h>
+#include <esl/com/http/server/RequestContext.h>
+#include <esl/com/http/server/Response.h>
+#include <esl/io/Output.h>
+#include <esl/object/Context.h>
+
+#include <cstddef>
+#include <string>
+
+namespace openjerry {
+namespace benchmark {
+
+
+/* Connection that drops every response and just counts it by its status code */
+class FakeConnection : public esl::com::http::server::Connection {
+public:
+	bool send(const esl::com::http::server::Response& response, esl::io::Output output) override;
+	bool sendFile(const esl::com::http::server::Response& response, const std::string& path) override;
+
+	std::size_t getNotFoundResponses() const noexcept;
+
+	/* responses with any other status code than 404 */
+	std::size_t getErrorResponses() const noexcept;
+
+private:
+	std::size_t notFoundResponses = 0;
+	std::size_t errorResponses = 0;
+
+	void count(const esl::com::http::server::Response& response) noexcept;
+};
+
+/* Request context as it would be provided by an http socket, without any network
+ * involved. It is created before measuring and can be used for many requests.
+ */
+class FakeRequestContext : public esl::com::http::server::RequestContext {
+public:
+	FakeRequestContext(const std::string& hostName, const std::string& method, const std::string& path);
+
+	esl::com::http::server::Connection& getConnection() const override;
+	const esl::com::http::server::Request& getRequest() const override;
+	const std::string& getPath() const override;
+
+	esl::object::Context& getObjectContext() override;
+	const esl::object::Context& getObjectContext() const override;
+
+	const FakeConnection& getFakeConnection() const noexcept;
+
+private:
+	mutable FakeConnection connection;
+	esl::com::http::server::Request request;
+	std::string path;
+	engine::ObjectContext objectContext;
+};
+
+
+} /* namespace benchmark */
+} /* namespace openjerry */
+
+#endif /* OPENJERRY_BENCHMARK_FAKEREQUESTCONTEXT_H_ */
@@ -0,0 +1,146 @@
+/*
+ * This file is part of Jerry application server.
+ * Copyright (C) 2020-2022 Sven Lukas
+ *
+ * Jerry is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as
+ * published by the Free Software Foundation, either version 3 of
+ * the License, or (at your option) any later version.
+ *
+ * Jerry is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public
+ * License along with Jerry.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include <openjerry/benchmark/TreeGenerator.h>
+#include <openjerry/engine/http/Endpoint.h>
+#include <openjerry/engine/http/Host.h>
+
+#include <esl/com/http/server/RequestHandler.h>
+#include <esl/com/http/server/RequestContext.h>
+#include <esl/io/Input.h>
+#include <esl/io/input/Closed.h>
+#include <esl/object/Context.h>
+#include <esl/object/Procedure.h>
+
+#include <cmath>
+#include <memory>
+
+namespace openjerry {
+namespace benchmark {
+
+
+namespace {
+class NoopProcedure : public esl::object::Procedure {
+public:
+	void procedureRun(esl::object::Context&) override {
+	}
+
+	void procedureCancel() override {
+	}
+};
+
+class RequestHandler : public esl::com::http::server::RequestHandler {
+public:
+	RequestHandler(bool aAccepting)
+	: accepting(aAccepting)
+	{ }
+
+	esl::io::Input accept(esl::com::http::server::RequestContext&) const override {
+		if(accepting) {
+			return esl::io::input::Closed::create();
+		}
+		return esl::io::Input();
+	}
+
+private:
+	const bool accepting;
+};
+} /* anonymous namespace */
+
+TreeGenerator::TreeGenerator(const TreeSettings& aSettings)
+: settings(aSettings)
+{
+	if(settings.depth > 0 && settings.endpoints > 1) {
+		fanOut = static_cast<std::size_t>(std::ceil(std::pow(static_cast<double>(settings.endpoints), 1.0 / static_cast<double>(settings.depth))));
+	}
+}
+
+void TreeGenerator::generate(engine::http::Context& serverContext) {
+	addEntries(serverContext);
+
+	if(settings.hosts == 0) {
+		std::size_t leafs = 0;
+		addEndpoints(serverContext, "", 1, leafs, true);
+		return;
+	}
+
+	for(std::size_t i = 0; i < settings.hosts; ++i) {
+		std::string hostName = "host" + std::to_string(i) + ".example.org";
+		std::unique_ptr<engine::http::Host> host(new engine::http::Host(nullptr, hostName));
+		engine::http::Host& hostRef = *host;
+
+		host->setParent(&serverContext);
+		serverContext.addHost(std::move(host));
+		hostNames.push_back(hostName);
+		++contexts;
+
+		addEntries(hostRef);
+
+		std::size_t leafs = 0;
+		addEndpoints(hostRef, "", 1, leafs, i == 0);
+	}
+}
+
+const std::vector<std::string>& TreeGenerator::getHostNames() const noexcept {
+	return hostNames;
+}
+
+const std::vector<std::string>& TreeGenerator::getPaths() const noexcept {
+	return paths;
+}
+
+std::size_t TreeGenerator::getContexts() const noexcept {
+	return contexts;
+}
+
+void TreeGenerator::addEntries(engine::http::Context& context) {
+	for(std::size_t i = 0; i < settings.procedures; ++i) {
+		context.addProcedure(std::unique_ptr<esl::object::Procedure>(new NoopProcedure));
+	}
+	for(std::size_t i = 0; i < settings.handlers; ++i) {
+		context.addRequestHandler(std::unique_ptr<esl::com::http::server::RequestHandler>(new RequestHandler(false)));
+	}
+}
+
+void TreeGenerator::addEndpoints(engine::http::Context& context, const std::string& path, std::size_t level, std::size_t& leafs, bool recordPaths) {
+	if(level > settings.depth) {
+		context.addRequestHandler(std::unique_ptr<esl::com::http::server::RequestHandler>(new RequestHandler(true)));
+		if(recordPaths) {
+			paths.push_back(path);
+		}
+		++leafs;
+		return;
+	}
+
+	for(std::size_t i = 0; i < fanOut && leafs < settings.endpoints; ++i) {
+		std::string endpointPath = "e" + std::to_string(level) + "-" + std::to_string(i);
+		std::unique_ptr<engine::http::Endpoint> endpoint(new engine::http::Endpoint(nullptr, endpointPath));
+		engine::http::Endpoint& endpointRef = *endpoint;
+
+		endpoint->setParent(&context);
+		context.addEndpoint(std::move(endpoint));
+		++contexts;
+
+		addEntries(endpointRef);
+		addEndpoints(endpointRef, path + "/" + endpointPath, level + 1, leafs, recordPaths);
+	}
+}
+
+
+} /* namespace benchmark */
+} /* namespace openjerry */
@@ -0,0 +1,79 @@
+/*
+ * This file is part of Jerry application server.
+ * Copyright (C) 2020-2022 Sven Lukas
+ *
+ * Jerry is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as
+ * published by the Free Software Foundation, either version 3 of
+ * the License, or (at your option) any later version.
+ *
+ * Jerry is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public
+ * License along with Jerry.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#ifndef OPENJERRY_BENCHMARK_TREEGENERATOR_H_
+#define OPENJERRY_BENCHMARK_TREEGENERATOR_H_
+
+#include <openjerry/engine/http/Context.h>
+
+#include <cstddef>
+#include <string>
+#include <vector>
+
+namespace openjerry {
+namespace benchmark {
+
+
+struct TreeSettings {
+	/* number of endpoints with an accepting request handler per host */
+	std::size_t endpoints = 100;
+
+	/* number of hosts, 0 puts the endpoints directly into the server context */
+	std::size_t hosts = 1;
+
+	/* nesting depth of endpoints */
+	std::size_t depth = 2;
+
+	/* number of procedures and not accepting request handlers added to each context */
+	std::size_t procedures = 1;
+	std::size_t handlers = 1;
+};
+
+/* Generates a synthetic context tree. Every context gets some procedures and request
+ * handlers that do not accept the request, the leaf endpoints get a handler that accepts it.
+ */
+class TreeGenerator {
+public:
+	TreeGenerator(const TreeSettings& settings);
+
+	void generate(engine::http::Context& serverContext);
+
+	const std::vector<std::string>& getHostNames() const noexcept;
+
+	/* request paths of all leaf endpoints */
+	const std::vector<std::string>& getPaths() const noexcept;
+
+	std::size_t getContexts() const noexcept;
+
+private:
+	const TreeSettings settings;
+	std::size_t fanOut = 1;
+
+	std::vector<std::string> hostNames;
+	std::vector<std::string> paths;
+	std::size_t contexts = 0;
+
+	void addEntries(engine::http::Context& context);
+	void addEndpoints(engine::http::Context& context, const std::string& path, std::size_t level, std::size_t& leafs, bool recordPaths);
+};
+
+
+} /* namespace benchmark */
+} /* namespace openjerry */
+
+#endif /* OPENJERRY_BENCHMARK_TREEGENERATOR_H_ */
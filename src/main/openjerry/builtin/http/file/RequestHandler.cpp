@@ -18,14 +18,11 @@
 
 #include <openjerry/builtin/http/file/RequestHandler.h>
 #include <openjerry/Logger.h>
-#include <openjerry/utility/MIME.h>
 
 #include <esl/com/http/server/Connection.h>
-#include <esl/com/http/server/Response.h>
 #include <esl/com/http/server/exception/StatusCode.h>
 #include <esl/io/input/Closed.h>
 #include <esl/system/Stacktrace.h>
-#include <esl/utility/MIME.h>
 
 #include <filesystem>
 #include <stdexcept>
@@ -56,21 +53,28 @@ RequestHandler::RequestHandler(const std::vector<std::pair<std::string, std::str
 				throw std::runtime_error("Invalid value \"" + setting.second + "\" for parameter key=\"" + setting.first + "\". Value must be an integer");
 			}
 		}
-		else {
+		else if(!fileSender.addSetting(setting.first, setting.second)) {
 			throw std::runtime_error("Unknown parameter key=\"" + setting.first + "\" with value=\"" + setting.second + "\"");
 		}
 	}
+
+	/* path rules of 'cache-control' see the file as "/<file name>" */
+	std::string::size_type pos = path.find_last_of('/');
+	if(pos != std::string::npos) {
+		fileSender.setRoot(path.substr(0, pos));
+	}
+	fileSender.initialize();
 }
 
 esl::io::Input RequestHandler::accept(esl::com::http::server::RequestContext& requestContext) const {
-	if(!std::filesystem::is_regular_file(path)) {
+	std::shared_ptr<const utility::FileCache::Entry> entry = fileSender.getEntry(path);
+
+	if(entry->type != utility::FileCache::Type::regularFile) {
 		logger.warn << "Path \"" << path << "\" is not a regular file\n";
 		throw esl::com::http::server::exception::StatusCode(404);
 	}
 
-    esl::utility::MIME mime = openjerry::utility::MIME::byFilename(path);
-	esl::com::http::server::Response response(httpStatus, mime);
-	requestContext.getConnection().sendFile(response, path);
+	fileSender.send(requestContext, httpStatus, path, *entry);
 	return esl::io::input::Closed::create();
 }
 
@@ -19,6 +19,8 @@
 #ifndef OPENJERRY_BUILTIN_HTTP_FILE_REQUESTHANDLER_H_
 #define OPENJERRY_BUILTIN_HTTP_FILE_REQUESTHANDLER_H_
 
+#include <openjerry/utility/FileSender.h>
+
 #include <esl/com/http/server/RequestContext.h>
 #include <esl/com/http/server/RequestHandler.h>
 #include <esl/io/Input.h>
@@ -44,6 +46,8 @@ public:
 private:
 	std::string path = "/";
 	int httpStatus = 200;
+
+	utility::FileSender fileSender;
 };
 
 } /* namespace file */
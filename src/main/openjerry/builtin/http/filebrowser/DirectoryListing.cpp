@@ -0,0 +1,119 @@
+/*
+ * This file is part of Jerry application server.
+ * Copyright (C) 2020-2022 Sven Lukas
+ *
+ * Jerry is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as
+ * published by the Free Software Foundation, either version 3 of
+ * the License, or (at your option) any later version.
+ *
+ * Jerry is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public
+ * License along with Jerry.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include <openjerry/builtin/http/filebrowser/DirectoryListing.h>
+#include <openjerry/Logger.h>
+
+#include <algorithm>
+#include <filesystem>
+#include <system_error>
+
+namespace openjerry {
+namespace builtin {
+namespace http {
+namespace filebrowser {
+
+namespace {
+Logger logger("openjerry::builtin::http::filebrowser::DirectoryListing");
+
+/* A directory modified within this time before loading its listing might be modified again
+ * without changing its modification time because of the timestamp granularity. Such a
+ * listing is not cached.
+ */
+constexpr std::chrono::seconds modificationGranularity(2);
+} /* anonymous namespace */
+
+DirectoryListing::DirectoryListing(std::size_t aMaxListings)
+: maxListings(aMaxListings)
+{ }
+
+std::shared_ptr<const DirectoryListing::Items> DirectoryListing::get(const std::string& path, const utility::FileCache::Entry& entry) {
+	{
+		std::lock_guard<std::mutex> lock(mutex);
+
+		auto iter = nodeByPath.find(path);
+		if(iter != nodeByPath.end()) {
+			if(iter->second->inode == entry.inode && iter->second->lastModified == entry.lastModified) {
+				nodes.splice(nodes.begin(), nodes, iter->second);
+				return iter->second->items;
+			}
+			nodes.erase(iter->second);
+			nodeByPath.erase(iter);
+		}
+	}
+
+	std::chrono::system_clock::time_point loadTime = std::chrono::system_clock::now();
+	std::shared_ptr<const Items> items = load(path);
+
+	if(maxListings == 0 || entry.lastModified + modificationGranularity > loadTime) {
+		return items;
+	}
+
+	std::lock_guard<std::mutex> lock(mutex);
+
+	auto iter = nodeByPath.find(path);
+	if(iter != nodeByPath.end()) {
+		nodes.erase(iter->second);
+		nodeByPath.erase(iter);
+	}
+
+	while(nodes.size() >= maxListings) {
+		nodeByPath.erase(nodes.back().path);
+		nodes.pop_back();
+	}
+
+	nodes.push_front(Node{path, entry.inode, entry.lastModified, items});
+	nodeByPath[path] = nodes.begin();
+
+	return items;
+}
+
+std::shared_ptr<const DirectoryListing::Items> DirectoryListing::load(const std::string& path) {
+	std::shared_ptr<Items> items(new Items);
+	std::error_code errorCode;
+
+	/* the type of a directory entry is taken from the directory itself if possible, so there
+	 * is no stat() call per entry except for symbolic links.
+	 */
+	for(std::filesystem::directory_iterator iter(path, errorCode), end; !errorCode && iter != end; iter.increment(errorCode)) {
+		std::error_code typeErrorCode;
+		Type type = Type::other;
+		if(iter->is_directory(typeErrorCode)) {
+			type = Type::directory;
+		}
+		else if(iter->is_regular_file(typeErrorCode)) {
+			type = Type::regularFile;
+		}
+		items->push_back(Item{iter->path().filename().generic_string(), type});
+	}
+
+	if(errorCode) {
+		logger.warn << "Could not read directory \"" << path << "\" completely (" << errorCode.message() << ").\n";
+	}
+
+	std::sort(items->begin(), items->end(), [](const Item& a, const Item& b) {
+		return a.name < b.name;
+	});
+
+	return items;
+}
+
+} /* namespace filebrowser */
+} /* namespace http */
+} /* namespace builtin */
+} /* namespace openjerry */
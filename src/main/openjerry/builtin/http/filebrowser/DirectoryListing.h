@@ -0,0 +1,87 @@
+/*
+ * This file is part of Jerry application server.
+ * Copyright (C) 2020-2022 Sven Lukas
+ *
+ * Jerry is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as
+ * published by the Free Software Foundation, either version 3 of
+ * the License, or (at your option) any later version.
+ *
+ * Jerry is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public
+ * License along with Jerry.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#ifndef OPENJERRY_BUILTIN_HTTP_FILEBROWSER_DIRECTORYLISTING_H_
+#define OPENJERRY_BUILTIN_HTTP_FILEBROWSER_DIRECTORYLISTING_H_
+
+#include <openjerry/utility/FileCache.h>
+
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <list>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+namespace openjerry {
+namespace builtin {
+namespace http {
+namespace filebrowser {
+
+/* Cache of directory listings sorted by name. A listing is valid as long as inode and
+ * modification time of the directory are unchanged. The least recently used listing is
+ * removed if there are more than 'maxListings' listings.
+ */
+class DirectoryListing {
+public:
+	enum class Type {
+		directory,
+		regularFile,
+		other
+	};
+
+	struct Item {
+		std::string name;
+		Type type;
+	};
+
+	using Items = std::vector<Item>;
+
+	DirectoryListing(std::size_t maxListings);
+
+	std::shared_ptr<const Items> get(const std::string& path, const utility::FileCache::Entry& entry);
+
+	/* reads the listing of directory 'path' without using a cache */
+	static std::shared_ptr<const Items> load(const std::string& path);
+
+private:
+	struct Node {
+		std::string path;
+		std::uint64_t inode;
+		std::chrono::system_clock::time_point lastModified;
+		std::shared_ptr<const Items> items;
+	};
+
+	const std::size_t maxListings;
+
+	std::mutex mutex;
+
+	/* most recently used node is at front */
+	std::list<Node> nodes;
+	std::unordered_map<std::string, std::list<Node>::iterator> nodeByPath;
+};
+
+} /* namespace filebrowser */
+} /* namespace http */
+} /* namespace builtin */
+} /* namespace openjerry */
+
+#endif /* OPENJERRY_BUILTIN_HTTP_FILEBROWSER_DIRECTORYLISTING_H_ */
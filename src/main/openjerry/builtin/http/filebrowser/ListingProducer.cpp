@@ -0,0 +1,219 @@
+/*
+ * This file is part of Jerry application server.
+ * Copyright (C) 2020-2022 Sven Lukas
+ *
+ * Jerry is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as
+ * published by the Free Software Foundation, either version 3 of
+ * the License, or (at your option) any later version.
+ *
+ * Jerry is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public
+ * License along with Jerry.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include <openjerry/builtin/http/filebrowser/ListingProducer.h>
+#include <openjerry/html/HTML.h>
+
+#include <algorithm>
+#include <cstdio>
+
+namespace openjerry {
+namespace builtin {
+namespace http {
+namespace filebrowser {
+
+namespace {
+/* size of a chunk that is rendered at once */
+constexpr std::size_t chunkSize = 16 * 1024;
+
+/* percent encoding of a file name as path segment of a link */
+std::string toURL(const std::string& name) {
+	static const char hex[] = "0123456789ABCDEF";
+	std::string result;
+
+	for(const unsigned char c : name) {
+		if((c >= 'a' && c <= 'z') || (c >= 'A' && c <= 'Z') || (c >= '0' && c <= '9')
+				|| c == '-' || c == '_' || c == '.' || c == '~') {
+			result += static_cast<char>(c);
+		}
+		else {
+			result += '%';
+			result += hex[c >> 4];
+			result += hex[c & 0x0f];
+		}
+	}
+
+	return result;
+}
+
+std::string toJSON(const std::string& str) {
+	std::string result;
+
+	for(const unsigned char c : str) {
+		switch(c) {
+		case '"':
+			result += "\\\"";
+			break;
+		case '\\':
+			result += "\\\\";
+			break;
+		case '\n':
+			result += "\\n";
+			break;
+		case '\r':
+			result += "\\r";
+			break;
+		case '\t':
+			result += "\\t";
+			break;
+		default:
+			if(c < 0x20) {
+				char buffer[7];
+				std::snprintf(buffer, sizeof(buffer), "\\u%04x", static_cast<unsigned int>(c));
+				result += buffer;
+			}
+			else {
+				result += static_cast<char>(c);
+			}
+			break;
+		}
+	}
+
+	return result;
+}
+
+const char* toString(DirectoryListing::Type type) {
+	switch(type) {
+	case DirectoryListing::Type::directory:
+		return "directory";
+	case DirectoryListing::Type::regularFile:
+		return "file";
+	case DirectoryListing::Type::other:
+		break;
+	}
+	return "other";
+}
+} /* anonymous namespace */
+
+ListingProducer::ListingProducer(std::shared_ptr<const DirectoryListing::Items> aItems, std::string aPath, std::size_t aOffset, std::size_t aLimit, Format aFormat)
+: items(std::move(aItems)),
+  path(std::move(aPath)),
+  offset(std::min(aOffset, items->size())),
+  limit(aLimit),
+  end(offset + std::min(limit, items->size() - offset)),
+  format(aFormat),
+  current(offset)
+{ }
+
+esl::io::Output ListingProducer::create(std::shared_ptr<const DirectoryListing::Items> items, std::string path, std::size_t offset, std::size_t limit, Format format) {
+	return esl::io::Output(std::unique_ptr<esl::io::Producer>(new ListingProducer(std::move(items), std::move(path), offset, limit, format)));
+}
+
+std::size_t ListingProducer::produce(esl::io::Writer& writer) {
+	if(bufferPos >= buffer.size()) {
+		fillBuffer();
+		if(buffer.empty()) {
+			return esl::io::Writer::npos;
+		}
+	}
+
+	std::size_t count = writer.write(buffer.data() + bufferPos, buffer.size() - bufferPos);
+	if(count != esl::io::Writer::npos) {
+		bufferPos += count;
+	}
+
+	return count;
+}
+
+void ListingProducer::fillBuffer() {
+	buffer.clear();
+	bufferPos = 0;
+
+	while(buffer.size() < chunkSize && state != State::done) {
+		switch(state) {
+		case State::header:
+			addHeader();
+			state = State::items;
+			break;
+		case State::items:
+			if(current < end) {
+				addItem((*items)[current]);
+				++current;
+			}
+			else {
+				state = State::footer;
+			}
+			break;
+		case State::footer:
+			addFooter();
+			state = State::done;
+			break;
+		case State::done:
+			break;
+		}
+	}
+}
+
+void ListingProducer::addHeader() {
+	if(format == Format::json) {
+		buffer += "{\"path\":\"" + toJSON(path) + "\",\"offset\":" + std::to_string(offset) + ",\"total\":" + std::to_string(items->size()) + ",\"entries\":[";
+		return;
+	}
+
+	std::string title = html::toHTML(path);
+	buffer += "<html><head><title>Directory of " + title + "</title></head><body><h2>Directory of " + title + "</h2><br/>";
+	buffer += "<a href=\"..\">..</a><br/>\n";
+}
+
+void ListingProducer::addItem(const DirectoryListing::Item& item) {
+	if(format == Format::json) {
+		if(current > offset) {
+			buffer += ',';
+		}
+		buffer += "{\"name\":\"" + toJSON(item.name) + "\",\"type\":\"" + toString(item.type) + "\"}";
+		return;
+	}
+
+	switch(item.type) {
+	case DirectoryListing::Type::directory:
+		buffer += "<a href=\"" + toURL(item.name) + "/\">" + html::toHTML(item.name) + "/</a><br/>\n";
+		break;
+	case DirectoryListing::Type::regularFile:
+		buffer += "<a href=\"" + toURL(item.name) + "\">" + html::toHTML(item.name) + "</a><br/>\n";
+		break;
+	case DirectoryListing::Type::other:
+		buffer += html::toHTML(item.name) + "<br/>\n";
+		break;
+	}
+}
+
+void ListingProducer::addFooter() {
+	if(format == Format::json) {
+		buffer += "]}";
+		return;
+	}
+
+	/* links to the previous and next page if the listing is paginated */
+	if(limit != std::string::npos && limit > 0) {
+		buffer += "<br/>\n";
+		if(offset > 0) {
+			std::size_t previousOffset = offset > limit ? offset - limit : 0;
+			buffer += "<a href=\"?offset=" + std::to_string(previousOffset) + "&amp;limit=" + std::to_string(limit) + "\">previous</a> ";
+		}
+		if(end < items->size()) {
+			buffer += "<a href=\"?offset=" + std::to_string(end) + "&amp;limit=" + std::to_string(limit) + "\">next</a>";
+		}
+		buffer += "<br/>\n";
+	}
+	buffer += "</body></html>";
+}
+
+} /* namespace filebrowser */
+} /* namespace http */
+} /* namespace builtin */
+} /* namespace openjerry */
@@ -0,0 +1,86 @@
+/*
+ * This file is part of Jerry application server.
+ * Copyright (C) 2020-2022 Sven Lukas
+ *
+ * Jerry is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as
+ * published by the Free Software Foundation, either version 3 of
+ * the License, or (at your option) any later version.
+ *
+ * Jerry is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public
+ * License along with Jerry.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#ifndef OPENJERRY_BUILTIN_HTTP_FILEBROWSER_LISTINGPRODUCER_H_
+#define OPENJERRY_BUILTIN_HTTP_FILEBROWSER_LISTINGPRODUCER_H_
+
+#include <openjerry/builtin/http/filebrowser/DirectoryListing.h>
+
+#include <esl/io/Output.h>
+#include <esl/io/Producer.h>
+#include <esl/io/Writer.h>
+
+#include <cstddef>
+#include <memory>
+#include <string>
+
+namespace openjerry {
+namespace builtin {
+namespace http {
+namespace filebrowser {
+
+/* Producer that renders a page of a directory listing as HTML or JSON in chunks,
+ * so the output of a large directory is never kept in memory completely.
+ */
+class ListingProducer : public esl::io::Producer {
+public:
+	enum class Format {
+		html,
+		json
+	};
+
+	/* 'limit' is the maximum number of items starting at item 'offset', std::string::npos means no limit */
+	ListingProducer(std::shared_ptr<const DirectoryListing::Items> items, std::string path, std::size_t offset, std::size_t limit, Format format);
+
+	static esl::io::Output create(std::shared_ptr<const DirectoryListing::Items> items, std::string path, std::size_t offset, std::size_t limit, Format format);
+
+	std::size_t produce(esl::io::Writer& writer) override;
+
+private:
+	enum class State {
+		header,
+		items,
+		footer,
+		done
+	};
+
+	std::shared_ptr<const DirectoryListing::Items> items;
+	std::string path;
+	std::size_t offset;
+	std::size_t limit;
+	std::size_t end;
+	Format format;
+
+	State state = State::header;
+	std::size_t current;
+
+	std::string buffer;
+	std::size_t bufferPos = 0;
+
+	void fillBuffer();
+	void addHeader();
+	void addItem(const DirectoryListing::Item& item);
+	void addFooter();
+};
+
+} /* namespace filebrowser */
+} /* namespace http */
+} /* namespace builtin */
+} /* namespace openjerry */
+
+#endif /* OPENJERRY_BUILTIN_HTTP_FILEBROWSER_LISTINGPRODUCER_H_ */
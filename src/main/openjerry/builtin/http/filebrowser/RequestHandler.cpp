@@ -17,15 +17,15 @@
  */
 
 #include <openjerry/builtin/http/filebrowser/RequestHandler.h>
+#include <openjerry/builtin/http/filebrowser/ListingProducer.h>
+#include <openjerry/utility/Number.h>
 #include <openjerry/Logger.h>
-#include <openjerry/utility/MIME.h>
 
 #include <esl/com/http/server/Connection.h>
 #include <esl/com/http/server/exception/StatusCode.h>
 #include <esl/com/http/server/Response.h>
 #include <esl/io/input/Closed.h>
 #include <esl/io/output/Memory.h>
-#include <esl/io/output/String.h>
 #include <esl/system/Stacktrace.h>
 #include <esl/utility/HttpMethod.h>
 #include <esl/utility/MIME.h>
@@ -36,6 +36,9 @@
 #include <fstream>
 #include <sstream>
 #include <stdexcept>
+#include <system_error>
+
+#include <fnmatch.h>
 
 namespace openjerry {
 namespace builtin {
@@ -55,6 +58,20 @@ const std::string PAGE_301(
 		"<h1>301</h1>\n"
 		"</body>\n"
 		"</html>\n");
+
+/* returns false if the query argument 'name' is present but not a number */
+bool getArgument(const esl::com::http::server::Request& request, const std::string& name, std::size_t& value) {
+	if(!request.hasArgument(name)) {
+		return true;
+	}
+
+	const std::string& str = request.getArgument(name);
+	if(str.empty() || str.size() > 19 || str.find_first_not_of("0123456789") != std::string::npos) {
+		return false;
+	}
+	value = static_cast<std::size_t>(std::stoull(str));
+	return true;
+}
 } /* anonymous namespace */
 
 std::unique_ptr<esl::com::http::server::RequestHandler> RequestHandler::createRequestHandler(const std::vector<std::pair<std::string, std::string>>& settings) {
@@ -63,6 +80,7 @@ std::unique_ptr<esl::com::http::server::RequestHandler> RequestHandler::createRe
 
 RequestHandler::RequestHandler(const std::vector<std::pair<std::string, std::string>>& settings) {
 	bool hasBrowsable = false;
+	bool hasListingCacheSize = false;
 
 	for(const auto& setting : settings) {
 		if(setting.first == "browsable") {
@@ -92,6 +110,15 @@ RequestHandler::RequestHandler(const std::vector<std::pair<std::string, std::str
 		else if(setting.first == "default") {
 			defaults.insert(setting.second);
 		}
+		else if(setting.first == "preload") {
+			/* "@file" is a manifest with one pattern per line, otherwise the value is a pattern */
+			if(!setting.second.empty() && setting.second.front() == '@') {
+				addPreloadManifest(setting.second.substr(1));
+			}
+			else {
+				preloadPatterns.push_back(setting.second);
+			}
+		}
 		else if(setting.first == "ignore-error") {
 			if(setting.second == "true") {
 				ignoreError = true;
@@ -103,15 +130,40 @@ RequestHandler::RequestHandler(const std::vector<std::pair<std::string, std::str
 				throw std::runtime_error("Unknown value \"" + setting.second + "\" for parameter key=\"" + setting.first + "\". Possible values are \"true\" or \"false\".");
 			}
 		}
+		else if(setting.first == "listing-cache-size") {
+			if(hasListingCacheSize) {
+				throw std::runtime_error("Multiple definition of attribute 'listing-cache-size'");
+			}
+			hasListingCacheSize = true;
+			listingCacheSize = utility::Number::toNumber(setting.first, setting.second);
+		}
 		/*
 		else if(setting.first == "accept-all") {
 			setAcceptAll(key, value, &Settings::setShowException);
 		}
 		*/
-		else {
+		else if(!fileSender.addSetting(setting.first, setting.second)) {
 			throw std::runtime_error("Unknown parameter key=\"" + setting.first + "\" with value=\"" + setting.second + "\"");
 		}
 	}
+
+	fileSender.setRoot(path.generic_string());
+	fileSender.initialize();
+
+	/* without a cache of file contents there is nothing to preload */
+	if(!preloadPatterns.empty() && !fileSender.hasContentCache()) {
+		throw std::runtime_error("Parameter 'preload' requires parameter 'cache-size'");
+	}
+
+	if(browsable) {
+		directoryListing.reset(new DirectoryListing(listingCacheSize));
+	}
+}
+
+void RequestHandler::initializeContext(esl::object::Context&) {
+	if(!preloadPatterns.empty()) {
+		preload();
+	}
 }
 
 esl::io::Input RequestHandler::accept(esl::com::http::server::RequestContext& requestContext) const {
@@ -137,7 +189,9 @@ esl::io::Input RequestHandler::accept(esl::com::http::server::RequestContext& re
 	logger.trace << "Base path '" << path << "'\n";
 	logger.trace << "Full path '" << fullPath << "'\n";
 
-	if(!std::filesystem::exists(fullPath)) {
+	std::shared_ptr<const utility::FileCache::Entry> entry = fileSender.getEntry(fullPath.generic_string());
+
+	if(entry->type == utility::FileCache::Type::notFound) {
 		logger.trace << "Original path " << fullPath << " not exists.\n";
 		if(ignoreError) {
 			return esl::io::Input();
@@ -147,7 +201,7 @@ esl::io::Input RequestHandler::accept(esl::com::http::server::RequestContext& re
 		}
 	}
 
-	if(std::filesystem::is_directory(fullPath)) {
+	if(entry->type == utility::FileCache::Type::directory) {
 		logger.trace << "Full path is a directory\n";
 		// if requestContext.getPath() pointing to a directury but not ending with character '/', then we will send a redirect to an URL ending with '/'
     	if(requestContext.getPath().empty() || requestContext.getPath().at(requestContext.getPath().size()-1) != '/') {
@@ -164,9 +218,11 @@ esl::io::Input RequestHandler::accept(esl::com::http::server::RequestContext& re
 		for(const auto& defaultFile : defaults) {
 			logger.trace << "enrich full path with default file '" << defaultFile << "'\n";
 			std::filesystem::path file = fullPath / defaultFile;
-			if(std::filesystem::exists(file) && std::filesystem::is_regular_file(file)) {
+			std::shared_ptr<const utility::FileCache::Entry> defaultEntry = fileSender.getEntry(file.generic_string());
+			if(defaultEntry->type == utility::FileCache::Type::regularFile) {
 				logger.trace << "File exists! Update full path...\n";
 				fullPath = file;
+				entry = defaultEntry;
 				break;
 			}
 			logger.trace << "Skip file, because it does not exists!\n";
@@ -175,30 +231,29 @@ esl::io::Input RequestHandler::accept(esl::com::http::server::RequestContext& re
 	}
 
 
-	if(std::filesystem::is_directory(fullPath)) {
+	if(entry->type == utility::FileCache::Type::directory) {
 		logger.trace << "Path " << fullPath << " is a directory\n";
     	if(browsable) {
-    		std::string outputContent;
-
-    		outputContent += "<html><head><title>Directory of " + requestContext.getPath() + "</title></head><body><h2>Directory of " + requestContext.getPath() + "</h2><br/>";
-    		outputContent += "<a href=\"..\">..</a><br/>\n";
-
-    		for (std::filesystem::directory_iterator itr(fullPath); itr!=std::filesystem::directory_iterator(); ++itr) {
-    			if(std::filesystem::is_directory(itr->path())) {
-    				outputContent += "<a href=\"" + itr->path().filename().generic_string() + "/\">" + itr->path().filename().generic_string() + "/</a><br/>\n";
-    			}
-    			else if(std::filesystem::is_regular_file(itr->path())) {
-    				outputContent += "<a href=\"" + itr->path().filename().generic_string() + "\">" + itr->path().filename().generic_string() + "</a><br/>\n";
-    			}
-    			else {
-    				outputContent += itr->path().filename().generic_string() + "<br/>\n";
-    			}
-    		}
-    		outputContent += "</body></html>";
-
-    		esl::com::http::server::Response response(200, esl::utility::MIME::Type::textHtml);
-    		esl::io::Output output = esl::io::output::String::create(std::move(outputContent));
-    		requestContext.getConnection().send(response, std::move(output));
+			const esl::com::http::server::Request& request = requestContext.getRequest();
+			std::size_t offset = 0;
+			std::size_t limit = std::string::npos;
+			if(!getArgument(request, "offset", offset) || !getArgument(request, "limit", limit)) {
+				throw esl::com::http::server::exception::StatusCode(400);
+			}
+
+			ListingProducer::Format format = ListingProducer::Format::html;
+			esl::utility::MIME mime = esl::utility::MIME::Type::textHtml;
+			const std::string* accept = utility::FileSender::findHeader(request, "Accept");
+			if(accept && esl::utility::String::toLower(*accept).find("application/json") != std::string::npos) {
+				format = ListingProducer::Format::json;
+				mime = esl::utility::MIME::Type::applicationJson;
+			}
+
+			std::shared_ptr<const DirectoryListing::Items> items = directoryListing->get(fullPath.generic_string(), *entry);
+
+    		esl::com::http::server::Response response(200, mime);
+			response.addHeader("Vary", "Accept");
+    		requestContext.getConnection().send(response, ListingProducer::create(std::move(items), requestContext.getPath(), offset, limit, format));
     		return esl::io::input::Closed::create();
     	}
 
@@ -211,10 +266,8 @@ esl::io::Input RequestHandler::accept(esl::com::http::server::RequestContext& re
 	}
 
 	logger.trace << "Path " << fullPath << " is a file\n";
-	if(std::filesystem::is_regular_file(fullPath)) {
-		esl::utility::MIME mime = openjerry::utility::MIME::byFilename(fullPath.generic_string());
-		esl::com::http::server::Response response(200, mime);
-		requestContext.getConnection().sendFile(response, fullPath.generic_string());
+	if(entry->type == utility::FileCache::Type::regularFile) {
+		fileSender.send(requestContext, 200, fullPath.generic_string(), *entry);
 		return esl::io::input::Closed::create();
 	}
 
@@ -226,6 +279,65 @@ esl::io::Input RequestHandler::accept(esl::com::http::server::RequestContext& re
 	throw esl::com::http::server::exception::StatusCode(422);
 }
 
+void RequestHandler::addPreloadManifest(const std::string& manifestFile) {
+	std::ifstream manifest(manifestFile);
+	if(!manifest.good()) {
+		throw std::runtime_error("Cannot read preload manifest \"" + manifestFile + "\"");
+	}
+
+	std::string line;
+	while(std::getline(manifest, line)) {
+		line = esl::utility::String::trim(esl::utility::String::trim(line, '\r'));
+		if(!line.empty() && line.front() != '#') {
+			preloadPatterns.push_back(line);
+		}
+	}
+}
+
+void RequestHandler::preload() {
+	auto isMatch = [this](const std::string& relativePath) {
+		for(const auto& pattern : preloadPatterns) {
+			if(fnmatch(pattern.c_str(), relativePath.c_str(), 0) == 0) {
+				return true;
+			}
+		}
+		return false;
+	};
+
+	std::size_t files = 0;
+	std::size_t directories = 0;
+	std::error_code errorCode;
+
+	for(std::filesystem::recursive_directory_iterator iter(path, errorCode), end; !errorCode && iter != end; iter.increment(errorCode)) {
+		std::string relativePath = iter->path().lexically_relative(path).generic_string();
+		if(!isMatch(relativePath)) {
+			continue;
+		}
+
+		std::error_code typeErrorCode;
+		if(iter->is_regular_file(typeErrorCode)) {
+			fileSender.preload(iter->path().generic_string());
+			++files;
+		}
+		else if(iter->is_directory(typeErrorCode)) {
+			/* resolve default documents, so the lookup of missing defaults is cached as well */
+			std::shared_ptr<const utility::FileCache::Entry> entry = fileSender.getEntry(iter->path().generic_string());
+			for(const auto& defaultFile : defaults) {
+				fileSender.preload((iter->path() / defaultFile).generic_string());
+			}
+			if(directoryListing && entry->type == utility::FileCache::Type::directory) {
+				directoryListing->get(iter->path().generic_string(), *entry);
+			}
+			++directories;
+		}
+	}
+
+	if(errorCode) {
+		logger.warn << "Could not preload directory " << path << " completely (" << errorCode.message() << ").\n";
+	}
+	logger.info << "Preloaded " << files << " files and " << directories << " directories of " << path << ".\n";
+}
+
 } /* namespace filebrowser */
 } /* namespace http */
 } /* namespace builtin */
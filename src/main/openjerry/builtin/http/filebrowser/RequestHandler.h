@@ -19,10 +19,16 @@
 #ifndef OPENJERRY_BUILTIN_HTTP_FILEBROWSER_REQUESTHANDLER_H_
 #define OPENJERRY_BUILTIN_HTTP_FILEBROWSER_REQUESTHANDLER_H_
 
+#include <openjerry/builtin/http/filebrowser/DirectoryListing.h>
+#include <openjerry/utility/FileSender.h>
+
 #include <esl/com/http/server/RequestContext.h>
 #include <esl/com/http/server/RequestHandler.h>
 #include <esl/io/Input.h>
+#include <esl/object/Context.h>
+#include <esl/object/InitializeContext.h>
 
+#include <cstddef>
 #include <filesystem>
 #include <memory>
 #include <string>
@@ -35,7 +41,7 @@ namespace builtin {
 namespace http {
 namespace filebrowser {
 
-class RequestHandler final : public esl::com::http::server::RequestHandler {
+class RequestHandler final : public virtual esl::com::http::server::RequestHandler, public esl::object::InitializeContext {
 public:
 	static std::unique_ptr<esl::com::http::server::RequestHandler> createRequestHandler(const std::vector<std::pair<std::string, std::string>>& settings);
 
@@ -43,11 +49,25 @@ public:
 
 	esl::io::Input accept(esl::com::http::server::RequestContext& requestContext) const override;
 
+	void initializeContext(esl::object::Context& objectContext) override;
+
 private:
 	bool browsable = false;
 	std::filesystem::path path;
 	std::set<std::string> defaults;
 	bool ignoreError = false;
+
+	/* number of cached directory listings, 0 disables the cache */
+	std::size_t listingCacheSize = 16;
+	std::unique_ptr<DirectoryListing> directoryListing;
+
+	/* glob patterns relative to 'path' of files and directories loaded into the caches at startup */
+	std::vector<std::string> preloadPatterns;
+
+	utility::FileSender fileSender;
+
+	void addPreloadManifest(const std::string& manifestFile);
+	void preload();
 };
 
 } /* namespace filebrowser */
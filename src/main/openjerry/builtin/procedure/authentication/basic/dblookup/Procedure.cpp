@@ -95,7 +95,7 @@ Procedure::Procedure(const std::vector<std::pair<std::string, std::string>>& set
 				throw std::runtime_error("Value \"0\" of parameter 'lifetime-ms' is invalid");
 			}
 		}
-		else {
+		else if(!sessionCacheSettings.addSetting(setting.first, setting.second)) {
 			throw std::runtime_error("Unknown parameter key=\"" + setting.first + "\" with value=\"" + setting.second + "\"");
 		}
 	}
@@ -112,6 +112,14 @@ Procedure::Procedure(const std::vector<std::pair<std::string, std::string>>& set
 	}
 }
 
+Procedure::~Procedure() {
+	if(sessionCache) {
+		logger.info << "Credential cache: " << sessionCache->getHits() << " hits, " << sessionCache->getNegativeHits() << " negative hits, " << sessionCache->getMisses() << " misses, " << sessionCache->getCoalesced() << " coalesced, "
+				<< sessionCache->getEvictions() << " evictions, " << sessionCache->getRejections() << " rejections, "
+				<< sessionCache->getEntries() << " entries and " << sessionCache->getNegativeEntries() << " unknown users with " << sessionCache->getBytes() << " bytes\n";
+	}
+}
+
 void Procedure::procedureRun(esl::object::Context& objectContext) {
 	Properties* authProperties = objectContext.findObject<Properties>("authenticated");
 	if(!authProperties) {
@@ -143,17 +151,24 @@ void Procedure::procedureRun(esl::object::Context& objectContext) {
 	std::string username = authProperties->get().at("basicauth-username");
 	std::string password = authProperties->get().at("basicauth-password");
 
-	/* lookup for an authorization object in our session pool */
-	auto object = sessionPool->get(username, username);
+	/* lookup for the credential in our session cache, with negative caching unknown users are cached as well */
+	std::shared_ptr<const Credential> object;
+	try {
+		object = sessionCache->get(username, username);
+	}
+	catch(const std::exception& e) {
+		/* a failed lookup is not cached, but the request is not authenticated as before */
+		logger.warn << "Loading credentials of user \"" << username << "\" failed: " << e.what() << "\n";
+		return;
+	}
 
-	/* if no object has been created then sessionPool-get(...) should have returned the existing object */
+	/* if no credential has been loaded then sessionCache->get(...) should have returned the existing credential */
 	if(!object) {
 		logger.warn << "No credentials found\n";
 		return;
 	}
 
-	/* the object should be give back into the session pool, so we have to clone it to put it into our object context */
-	Credential* credential = object.get();
+	const Credential* credential = object.get();
 	if(credential) {
 		if(std::get<0>(*credential) == plain) {
 			if(std::get<1>(*credential) != password) {
@@ -181,9 +196,11 @@ void Procedure::initializeContext(esl::object::Context& objectContext) {
 		throw std::runtime_error("Cannot find connection factory with id \"" + connectionId + "\"");
 	}
 
-	sessionPool.reset(new SessionPool([this](const std::string& username) {
+	sessionCache.reset(new SessionCache([this](const std::string& username) {
 		return loadCredentialsDynamic(username);
-	}, 10, lifetimeMs, lifetimeRenew, false));
+	}, sessionCacheSettings, lifetimeMs, lifetimeRenew, [](const std::string& username, const Credential* credential) {
+		return username.capacity() + (credential ? std::get<1>(*credential).capacity() : 0);
+	}));
 }
 
 Procedure::Credential Procedure::parseCredential(const std::string& credential) {
@@ -225,20 +242,17 @@ Procedure::Credential Procedure::parseCredential(const std::string& credential)
 
 std::unique_ptr<Procedure::Credential> Procedure::loadCredentialsDynamic(const std::string& username) {
 	if(connectionFactory == nullptr) {
-		logger.warn << "No DB connection factory initialized.\n";
-		return nullptr;
+		return loadFailed("No DB connection factory initialized");
 	}
 
 	std::unique_ptr<esl::database::Connection> connection = connectionFactory->createConnection();
 	if(!connection) {
-		logger.warn << "Could not create DB connection\n";
-		return nullptr;
+		return loadFailed("Could not create DB connection");
 	}
 
     esl::database::PreparedStatement preparedStatement = connection->prepare(sql);
 	if(preparedStatement.getResultColumns().size() != 1) {
-		logger.warn << "SQL result set has " << preparedStatement.getResultColumns().size() << " columns, but should have 1 column.\n";
-		return nullptr;
+		return loadFailed("SQL result set has " + std::to_string(preparedStatement.getResultColumns().size()) + " columns, but should have 1 column");
 	}
 
     esl::database::ResultSet resultSet = preparedStatement.execute(username);
@@ -255,6 +269,16 @@ std::unique_ptr<Procedure::Credential> Procedure::loadCredentialsDynamic(const s
 	return std::unique_ptr<Credential>(new Credential(parseCredential(resultSet[0].asString())));
 }
 
+std::unique_ptr<Procedure::Credential> Procedure::loadFailed(const std::string& message) const {
+	/* with negative caching a nullptr would be cached as unknown user, so the failure is thrown */
+	if(sessionCacheSettings.getMaxNegativeEntries() > 0) {
+		throw std::runtime_error(message);
+	}
+
+	logger.warn << message << ".\n";
+	return nullptr;
+}
+
 } /* namespace dblookup */
 } /* namespace basic */
 } /* namespace authentication */
@@ -19,12 +19,14 @@
 #ifndef OPENJERRY_BUILTIN_PROCEDURE_AUTHENTICATION_BASIC_DBLOOKUP2_PROCEDURE_H_
 #define OPENJERRY_BUILTIN_PROCEDURE_AUTHENTICATION_BASIC_DBLOOKUP2_PROCEDURE_H_
 
+#include <openjerry/utility/SessionCache.h>
+#include <openjerry/utility/SessionCacheSettings.h>
+
 #include <esl/database/ConnectionFactory.h>
 #include <esl/object/Context.h>
 #include <esl/object/InitializeContext.h>
 #include <esl/object/Procedure.h>
 #include <esl/object/Value.h>
-#include <esl/utility/SessionPool.h>
 
 #include <chrono>
 #include <map>
@@ -46,6 +48,7 @@ public:
 	static std::unique_ptr<esl::object::Procedure> create(const std::vector<std::pair<std::string, std::string>>& settings);
 
 	Procedure(const std::vector<std::pair<std::string, std::string>>& settings);
+	~Procedure();
 
 	void initializeContext(esl::object::Context& objectContext) override;
 
@@ -58,7 +61,7 @@ private:
 	};
 	using Properties = esl::object::Value<std::map<std::string, std::string>>;
 	using Credential = std::tuple<Type, std::string>;
-	using SessionPool = esl::utility::SessionPool<Credential, std::string, std::string>;
+	using SessionCache = utility::SessionCache<Credential, std::string, std::string>;
 
 	std::string connectionId;
 	std::string sql;
@@ -66,10 +69,14 @@ private:
 	std::chrono::milliseconds lifetimeMs = std::chrono::milliseconds(0);
 	bool lifetimeRenew = false;
 
-	std::unique_ptr<SessionPool> sessionPool;
+	utility::SessionCacheSettings sessionCacheSettings;
+	std::unique_ptr<SessionCache> sessionCache;
 
 	static Credential parseCredential(const std::string& credential);
+	/* returns nullptr if the user is unknown, if the database cannot be queried it throws an exception
+	 * with negative caching and returns nullptr without */
 	std::unique_ptr<Credential> loadCredentialsDynamic(const std::string& username);
+	std::unique_ptr<Credential> loadFailed(const std::string& message) const;
 };
 
 } /* namespace dblookup */
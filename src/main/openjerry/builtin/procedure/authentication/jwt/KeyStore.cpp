@@ -0,0 +1,378 @@
+/*
+ * This file is part of Jerry application server.
+ * Copyright (C) 2020-2022 Sven Lukas
+ *
+ * Jerry is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as
+ * published by the Free Software Foundation, either version 3 of
+ * the License, or (at your option) any later version.
+ *
+ * Jerry is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public
+ * License along with Jerry.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include <openjerry/builtin/procedure/authentication/jwt/KeyStore.h>
+#include <openjerry/Logger.h>
+
+#include <esl/com/http/client/Request.h>
+#include <esl/com/http/client/Response.h>
+#include <esl/io/Input.h>
+#include <esl/io/input/String.h>
+#include <esl/io/Output.h>
+#include <esl/utility/HttpMethod.h>
+#include <esl/utility/MIME.h>
+#include <esl/utility/String.h>
+
+#include "rapidjson/document.h"
+
+#include <gnutls/gnutls.h>
+
+#include <algorithm>
+#include <future>
+#include <utility>
+#include <vector>
+
+#include <strings.h>
+
+namespace openjerry {
+namespace builtin {
+namespace procedure {
+namespace authentication {
+namespace jwt {
+
+namespace {
+Logger logger("openjerry::builtin::procedure::authentication::jwt::KeyStore");
+
+/* returns the max-age of a Cache-Control header, 0 for no-cache or no-store and -1 if there is none */
+std::chrono::seconds getMaxAge(const std::map<std::string, std::string>& headers) {
+	for(const auto& header : headers) {
+		if(strcasecmp(header.first.c_str(), "Cache-Control") != 0) {
+			continue;
+		}
+
+		for(const auto& directive : esl::utility::String::split(header.second, ',')) {
+			std::string value = esl::utility::String::toLower(esl::utility::String::trim(directive));
+			if(value == "no-cache" || value == "no-store") {
+				return std::chrono::seconds(0);
+			}
+			if(value.rfind("max-age=", 0) == 0) {
+				try {
+					return std::chrono::seconds(std::stol(value.substr(8)));
+				}
+				catch(...) {
+				}
+			}
+		}
+	}
+	return std::chrono::seconds(-1);
+}
+} /* anonymous namespace */
+
+KeyStore::KeyStore(const ConnectionFactories& aConnectionFactories, std::chrono::seconds aRefreshInterval, std::chrono::seconds aMinFetchInterval)
+: connectionFactories(aConnectionFactories),
+  refreshInterval(aRefreshInterval),
+  minFetchInterval(aMinFetchInterval),
+  keys(std::make_shared<const Keys>()),
+  lastFetch(std::chrono::steady_clock::now() - aMinFetchInterval),
+  nextRefresh(std::chrono::steady_clock::now())
+{
+	if(!connectionFactories.empty()) {
+		refreshThread = std::thread(&KeyStore::runRefresh, this);
+	}
+}
+
+KeyStore::~KeyStore() {
+	{
+		std::lock_guard<std::mutex> lock(mutex);
+		stopped = true;
+	}
+	condition.notify_all();
+
+	if(refreshThread.joinable()) {
+		refreshThread.join();
+	}
+}
+
+std::shared_ptr<const KeyStore::Key> KeyStore::get(const std::string& kid) {
+	std::shared_ptr<const Keys> currentKeys = keys.load();
+	auto iter = currentKeys->find(kid);
+	if(iter != currentKeys->end()) {
+		return iter->second;
+	}
+
+	if(connectionFactories.empty() || !refresh(true)) {
+		return nullptr;
+	}
+
+	currentKeys = keys.load();
+	iter = currentKeys->find(kid);
+	if(iter != currentKeys->end()) {
+		return iter->second;
+	}
+	return nullptr;
+}
+
+bool KeyStore::refresh(bool onDemand) {
+	{
+		std::unique_lock<std::mutex> lock(mutex);
+
+		/* Coalesce with the refresh in progress. Lookups on demand do not wait for it once there are keys,
+		 * otherwise tokens with forged kids could park every worker for the time of a fetch. */
+		if(fetching) {
+			if(onDemand && fetched) {
+				return false;
+			}
+			condition.wait(lock, [this] { return !fetching; });
+			return true;
+		}
+
+		if(stopped || (onDemand && std::chrono::steady_clock::now() < lastFetch + minFetchInterval)) {
+			return false;
+		}
+		fetching = true;
+	}
+
+	std::chrono::seconds maxAge = refreshInterval;
+	bool refreshed = true;
+
+	/* 'fetching' must be reset on every path, otherwise all later refreshes would wait forever */
+	try {
+		std::vector<std::future<FetchResult>> futures;
+		for(const auto& connectionFactory : connectionFactories) {
+			futures.push_back(std::async(std::launch::async, &KeyStore::fetch, connectionFactory.first, std::ref(connectionFactory.second.get())));
+		}
+
+		auto futureIter = futures.begin();
+		for(const auto& connectionFactory : connectionFactories) {
+			auto& future = *futureIter++;
+			FetchResult fetchResult;
+			try {
+				fetchResult = future.get();
+			}
+			catch(const std::exception& e) {
+				logger.warn << "Fetching JWKS failed: " << e.what() << "\n";
+			}
+			catch(...) {
+				logger.warn << "Fetching JWKS failed because of an unknown exception.\n";
+			}
+
+			/* keep the previous keys of a JWKS server that could not be reached */
+			if(!fetchResult.success) {
+				continue;
+			}
+
+			keysByServer[connectionFactory.first] = std::move(fetchResult.keys);
+			if(fetchResult.maxAge >= std::chrono::seconds(0)) {
+				maxAge = std::min(maxAge, fetchResult.maxAge);
+			}
+		}
+
+		std::shared_ptr<Keys> newKeys(new Keys);
+		for(const auto& serverKeys : keysByServer) {
+			newKeys->insert(serverKeys.second.begin(), serverKeys.second.end());
+		}
+		keys.store(std::move(newKeys));
+	}
+	catch(const std::exception& e) {
+		logger.warn << "Refreshing JWKS failed: " << e.what() << "\n";
+		refreshed = false;
+		maxAge = std::chrono::seconds(0);
+	}
+	catch(...) {
+		logger.warn << "Refreshing JWKS failed because of an unknown exception.\n";
+		refreshed = false;
+		maxAge = std::chrono::seconds(0);
+	}
+
+	{
+		std::lock_guard<std::mutex> lock(mutex);
+		fetching = false;
+		fetched = true;
+		lastFetch = std::chrono::steady_clock::now();
+		nextRefresh = lastFetch + std::max(maxAge, minFetchInterval);
+	}
+	condition.notify_all();
+
+	return refreshed;
+}
+
+void KeyStore::runRefresh() {
+	std::unique_lock<std::mutex> lock(mutex);
+
+	while(!stopped) {
+		if(fetching) {
+			condition.wait(lock);
+			continue;
+		}
+
+		if(std::chrono::steady_clock::now() >= nextRefresh) {
+			lock.unlock();
+			refresh(false);
+			lock.lock();
+			continue;
+		}
+
+		condition.wait_until(lock, nextRefresh);
+	}
+}
+
+KeyStore::FetchResult KeyStore::fetch(const std::string& id, esl::com::http::client::ConnectionFactory& connectionFactory) {
+	FetchResult fetchResult;
+
+	auto connection = connectionFactory.createConnection();
+	if(!connection) {
+		logger.warn << "Could not get an connection object for JWKS server with id \"" << id << "\".\n";
+		return fetchResult;
+	}
+	esl::com::http::client::Request request("", esl::utility::HttpMethod::Type::httpGet, esl::utility::MIME());
+	esl::io::input::String inputString;
+
+	esl::com::http::client::Response response = connection->send(request, esl::io::Output(), esl::io::Input(inputString));
+
+	if(response.getStatusCode() < 200 || response.getStatusCode() > 299) {
+		logger.warn << "JWKS server response with HTTP status code " << response.getStatusCode() << ".\n";
+		return fetchResult;
+	}
+
+	logger.info << "HTTP response:\n";
+	logger.info << "- content type: " << response.getContentType().toString() << "\n";
+
+	parseKeys(inputString.getString(), fetchResult.keys);
+	fetchResult.maxAge = getMaxAge(response.getHeaders());
+	fetchResult.success = true;
+
+	return fetchResult;
+}
+
+void KeyStore::parseKeys(const std::string& jwks, Keys& keys) {
+	rapidjson::Document document;
+	document.Parse(jwks.c_str());
+
+	if(!document.IsObject()) {
+		logger.warn << "JWKS content is not a JSON object.\n";
+		return;
+	}
+
+	if(!document.HasMember("keys") || !document["keys"].IsArray()) {
+		logger.warn << "JWKS object has no \"keys\" array.\n";
+		return;
+	}
+
+	auto jsonArray = document["keys"].GetArray();
+	for(rapidjson::Value::ConstValueIterator iter = jsonArray.Begin(); iter != jsonArray.End(); ++iter) {
+		if(!iter->IsObject()) {
+			logger.warn << "JWK object has no \"keys\" array.\n";
+			continue;
+		}
+
+		std::string kid;
+		if(iter->HasMember("kid") && (*iter)["kid"].IsString()) {
+			kid = (*iter)["kid"].GetString();
+		}
+
+		if(!iter->HasMember("kty") || !(*iter)["kty"].IsString()) {
+			logger.warn << "JWK object has no string member \"kty\".\n";
+			continue;
+		}
+		std::string kty = (*iter)["kty"].GetString();
+
+		if(kty == "RSA") {
+			std::string use = "sig";
+			if(iter->HasMember("use") && (*iter)["use"].IsString()) {
+				use = (*iter)["use"].GetString();
+			}
+			if(use != "sig") {
+				continue;
+			}
+
+			if(!iter->HasMember("n") || !(*iter)["n"].IsString()) {
+				logger.warn << "JWK object has no string member \"n\".\n";
+				continue;
+			}
+			std::string modulus = esl::utility::String::fromBase64((*iter)["n"].GetString());
+
+			if(!iter->HasMember("e") || !(*iter)["e"].IsString()) {
+				logger.warn << "JWK object has no string member \"e\".\n";
+				continue;
+			}
+			std::string exponent = esl::utility::String::fromBase64((*iter)["e"].GetString());
+
+			std::string alg = "RS256";
+			if(iter->HasMember("alg") && (*iter)["alg"].IsString()) {
+				alg = (*iter)["alg"].GetString();
+			}
+
+			logger.info << "Store public key for KID \"" << kid << "\" with algorithm \"" << alg << "\"\n";
+			keys.insert(std::make_pair(kid, std::make_shared<const Key>(Key{gtx::PublicKey::createRSA(exponent, modulus), alg})));
+		}
+		else if(kty == "EC") {
+			std::string use = "sig";
+			if(iter->HasMember("use") && (*iter)["use"].IsString()) {
+				use = (*iter)["use"].GetString();
+			}
+			if(use != "sig") {
+				continue;
+			}
+
+			if(!iter->HasMember("x") || !(*iter)["x"].IsString()) {
+				logger.warn << "JWK object has no string member \"x\".\n";
+				continue;
+			}
+			std::string coordinateX = (*iter)["x"].GetString();
+
+			if(!iter->HasMember("y") || !(*iter)["y"].IsString()) {
+				logger.warn << "JWK object has no string member \"y\".\n";
+				continue;
+			}
+			std::string coordinateY = (*iter)["y"].GetString();
+
+			std::string crv = "P-256";
+			if(iter->HasMember("crv") && (*iter)["crv"].IsString()) {
+				crv = (*iter)["crv"].GetString();
+			}
+
+			gnutls_ecc_curve_t curveType = GNUTLS_ECC_CURVE_INVALID;
+			if(crv == "P-192") {
+				curveType = GNUTLS_ECC_CURVE_SECP192R1;
+			}
+			else if(crv == "P-224") {
+				curveType = GNUTLS_ECC_CURVE_SECP224R1;
+			}
+			else if(crv == "P-256") {
+				curveType = GNUTLS_ECC_CURVE_SECP256R1;
+			}
+			else if(crv == "P-384") {
+				curveType = GNUTLS_ECC_CURVE_SECP384R1;
+			}
+			else if(crv == "P-521") {
+				curveType = GNUTLS_ECC_CURVE_SECP521R1;
+			}
+			else {
+				logger.warn << "JWK object has an unknown EC curve type \"" << crv << "\".\n";
+				continue;
+			}
+
+			std::string alg = "ES256";
+			if(iter->HasMember("alg") && (*iter)["alg"].IsString()) {
+				alg = (*iter)["alg"].GetString();
+			}
+
+			keys.insert(std::make_pair(kid, std::make_shared<const Key>(Key{gtx::PublicKey::createEC(curveType, coordinateX, coordinateY), alg})));
+		}
+		else {
+			logger.warn << "Value \"" << kty << "\" of JWK member \"kty\" is not supported. Supported values are \"RSA\" and \"EC\".\n";
+			continue;
+		}
+	}
+}
+
+} /* namespace jwt */
+} /* namespace authentication */
+} /* namespace procedure */
+} /* namespace builtin */
+} /* namespace openjerry */
@@ -0,0 +1,104 @@
+/*
+ * This file is part of Jerry application server.
+ * Copyright (C) 2020-2022 Sven Lukas
+ *
+ * Jerry is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as
+ * published by the Free Software Foundation, either version 3 of
+ * the License, or (at your option) any later version.
+ *
+ * Jerry is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public
+ * License along with Jerry.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#ifndef OPENJERRY_BUILTIN_PROCEDURE_AUTHENTICATION_JWT_KEYSTORE_H_
+#define OPENJERRY_BUILTIN_PROCEDURE_AUTHENTICATION_JWT_KEYSTORE_H_
+
+#include <esl/com/http/client/ConnectionFactory.h>
+
+#include <gtx/PublicKey.h>
+
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <functional>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+
+namespace openjerry {
+namespace builtin {
+namespace procedure {
+namespace authentication {
+namespace jwt {
+
+/* Public keys of JWKS servers. Readers get the keys from an immutable snapshot without locking,
+ * a refresh builds a new snapshot and swaps it atomically. Keys are refreshed by a background
+ * thread as given by Cache-Control of the JWKS responses. An unknown kid triggers a refresh on
+ * demand, but it is rate limited by 'minFetchInterval' and it does not wait for a refresh in
+ * progress, except for the first one.
+ */
+class KeyStore {
+public:
+	struct Key {
+		std::unique_ptr<gtx::PublicKey> publicKey;
+		std::string alg;
+	};
+
+	using ConnectionFactories = std::map<std::string, std::reference_wrapper<esl::com::http::client::ConnectionFactory>>;
+
+	KeyStore(const ConnectionFactories& connectionFactories, std::chrono::seconds refreshInterval, std::chrono::seconds minFetchInterval);
+	~KeyStore();
+
+	/* returns nullptr if there is no key with id 'kid' */
+	std::shared_ptr<const Key> get(const std::string& kid);
+
+private:
+	using Keys = std::map<std::string, std::shared_ptr<const Key>>;
+
+	struct FetchResult {
+		bool success = false;
+		Keys keys;
+		std::chrono::seconds maxAge{-1};
+	};
+
+	const ConnectionFactories connectionFactories;
+	const std::chrono::seconds refreshInterval;
+	const std::chrono::seconds minFetchInterval;
+
+	std::atomic<std::shared_ptr<const Keys>> keys;
+
+	/* keys of the last successful fetch per JWKS server id, only used by the thread that is fetching */
+	std::map<std::string, Keys> keysByServer;
+
+	std::mutex mutex;
+	std::condition_variable condition;
+	bool fetching = false;
+	bool fetched = false;
+	bool stopped = false;
+	std::chrono::steady_clock::time_point lastFetch;
+	std::chrono::steady_clock::time_point nextRefresh;
+	std::thread refreshThread;
+
+	/* fetches the keys from all JWKS servers in parallel, returns false if there are no new keys to look at */
+	bool refresh(bool onDemand);
+	void runRefresh();
+
+	static FetchResult fetch(const std::string& id, esl::com::http::client::ConnectionFactory& connectionFactory);
+	static void parseKeys(const std::string& jwks, Keys& keys);
+};
+
+} /* namespace jwt */
+} /* namespace authentication */
+} /* namespace procedure */
+} /* namespace builtin */
+} /* namespace openjerry */
+
+#endif /* OPENJERRY_BUILTIN_PROCEDURE_AUTHENTICATION_JWT_KEYSTORE_H_ */
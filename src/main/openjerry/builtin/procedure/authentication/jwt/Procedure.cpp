@@ -17,21 +17,13 @@
  */
 
 #include <openjerry/builtin/procedure/authentication/jwt/Procedure.h>
+#include <openjerry/utility/Number.h>
 #include <openjerry/Logger.h>
 
-#include <esl/com/http/client/Request.h>
-#include <esl/com/http/client/Response.h>
-#include <esl/io/Input.h>
-#include <esl/io/input/String.h>
-#include <esl/io/Output.h>
-#include <esl/utility/HttpMethod.h>
-#include <esl/utility/MIME.h>
 #include <esl/utility/String.h>
 
 #include "rapidjson/document.h"
 
-#include <gnutls/gnutls.h>
-
 #include <ctime>
 #include <stdexcept>
 
@@ -50,6 +42,12 @@ std::unique_ptr<esl::object::Procedure> Procedure::create(const std::vector<std:
 }
 
 Procedure::Procedure(const std::vector<std::pair<std::string, std::string>>& settings) {
+	bool hasCacheSize = false;
+	bool hasCacheShards = false;
+	bool hasCacheMaxTtl = false;
+	bool hasJwksRefreshInterval = false;
+	bool hasJwksMinFetchInterval = false;
+
 	for(const auto& setting : settings) {
 		if(setting.first == "drop-field") {
 			if(setting.second.empty()) {
@@ -71,10 +69,58 @@ Procedure::Procedure(const std::vector<std::pair<std::string, std::string>>& set
 			}
 			jwksConnectionFactoryIds.insert(setting.second);
 		}
+		else if(setting.first == "jwks-refresh-interval") {
+			if(hasJwksRefreshInterval) {
+				throw std::runtime_error("Multiple definition of attribute 'jwks-refresh-interval'");
+			}
+			hasJwksRefreshInterval = true;
+			jwksRefreshInterval = std::chrono::seconds(utility::Number::toNumber(setting.first, setting.second));
+			if(jwksRefreshInterval.count() == 0) {
+				throw std::runtime_error("Value \"0\" of parameter 'jwks-refresh-interval' is invalid");
+			}
+		}
+		else if(setting.first == "jwks-min-fetch-interval") {
+			if(hasJwksMinFetchInterval) {
+				throw std::runtime_error("Multiple definition of attribute 'jwks-min-fetch-interval'");
+			}
+			hasJwksMinFetchInterval = true;
+			jwksMinFetchInterval = std::chrono::seconds(utility::Number::toNumber(setting.first, setting.second));
+		}
+		else if(setting.first == "cache-size") {
+			if(hasCacheSize) {
+				throw std::runtime_error("Multiple definition of attribute 'cache-size'");
+			}
+			hasCacheSize = true;
+			cacheSize = utility::Number::toNumber(setting.first, setting.second);
+		}
+		else if(setting.first == "cache-shards") {
+			if(hasCacheShards) {
+				throw std::runtime_error("Multiple definition of attribute 'cache-shards'");
+			}
+			hasCacheShards = true;
+			cacheShards = utility::Number::toNumber(setting.first, setting.second);
+			if(cacheShards == 0) {
+				throw std::runtime_error("Value \"0\" of parameter 'cache-shards' is invalid");
+			}
+		}
+		else if(setting.first == "cache-max-ttl") {
+			if(hasCacheMaxTtl) {
+				throw std::runtime_error("Multiple definition of attribute 'cache-max-ttl'");
+			}
+			hasCacheMaxTtl = true;
+			cacheMaxTtl = static_cast<std::time_t>(utility::Number::toNumber(setting.first, setting.second));
+		}
 		else {
 			throw std::runtime_error("Unknown parameter key=\"" + setting.first + "\" with value=\"" + setting.second + "\"");
 		}
 	}
+
+	if(cacheSize > 0) {
+		tokenCache.reset(new TokenCache(cacheSize, cacheShards));
+	}
+	else if(hasCacheShards || hasCacheMaxTtl) {
+		throw std::runtime_error("Parameters 'cache-shards' and 'cache-max-ttl' require parameter 'cache-size'");
+	}
 }
 
 void Procedure::initializeContext(esl::object::Context& objectContext) {
@@ -85,6 +131,8 @@ void Procedure::initializeContext(esl::object::Context& objectContext) {
 		}
 		jwksConnectionFactories.insert(std::make_pair(jwksConnectionFactoryId, std::ref(*connectionFactory)));
 	}
+
+	keyStore.reset(new KeyStore(jwksConnectionFactories, jwksRefreshInterval, jwksMinFetchInterval));
 }
 
 void Procedure::procedureRun(esl::object::Context& objectContext) {
@@ -117,6 +165,22 @@ void Procedure::procedureRun(esl::object::Context& objectContext) {
 
     std::time_t currentTime = std::time(nullptr);
 
+	/* a token that has been verified already needs a hash lookup only */
+	std::string cacheKey;
+	if(tokenCache && authProperties->get().count("jwt-signature") != 0) {
+		cacheKey = TokenCache::createKey(authProperties->get().at("jwt-data"), authProperties->get().at("jwt-signature"));
+
+		TokenCache::Claims claims;
+		if(tokenCache->get(cacheKey, currentTime, claims)) {
+			if(dropFields.count("aud") == 0 && claims.aud != authProperties->get().at("jwt-aud")) {
+				logger.warn << "Web-Token is issued for \"" << claims.aud << "\" but used for \"" << authProperties->get().at("jwt-aud") << "\".\n";
+				return;
+			}
+			authProperties->get()["identified"] = claims.identified;
+			return;
+		}
+	}
+
 	/* iss  Issuer           Der Aussteller des Tokens
 	 * sub  Subject          Definiert für welches Subjekt die Claims gelten. Das sub-Feld definiert also für wen oder was die Claims getätigt werden.
 	 * aud  Audience         Die Zieldomäne, für die das Token ausgestellt wurde.
@@ -180,10 +244,10 @@ void Procedure::procedureRun(esl::object::Context& objectContext) {
 		nbf = currentTime;
 	}
 	else if(overrideFields.count("nbf") != 0) {
-		exp = std::stol(overrideFields.at("nbf"));
+		nbf = std::stol(overrideFields.at("nbf"));
 	}
 	else if(document.HasMember("nbf") && document["nbf"].IsUint64()) {
-		exp = document["nbf"].GetInt64();
+		nbf = document["nbf"].GetInt64();
 	}
 
 	if(currentTime < nbf) {
@@ -226,20 +290,20 @@ void Procedure::procedureRun(esl::object::Context& objectContext) {
 			logger.warn << "Field \"alg\" is missing in JWT header.\n";
 		}
 
-		std::pair<gtx::PublicKey*, std::string> publicKey = getPublicKeyById(kid);
-		if(publicKey.first) {
+		std::shared_ptr<const KeyStore::Key> publicKey = getPublicKeyById(kid);
+		if(publicKey) {
 			std::string data = authProperties->get().at("jwt-data");
 			std::string signature = authProperties->get().at("jwt-signature");
 
 			if(alg.empty()) {
-				alg = publicKey.second;
+				alg = publicKey->alg;
 			}
 			logger.trace << "JWT kid : \"" << kid << "\"\n";
 			logger.trace << "JWT alg : \"" << alg << "\"\n";
 			logger.trace << "JWT data: \"" << data << "\" (" << data.size() << " bytes)\n";
 			logger.trace << "JWT sign: \"...\" (" << signature.size() << " bytes)\n";
 
-			if(publicKey.first->verifySignature(data, signature, alg) == false) {
+			if(publicKey->publicKey->verifySignature(data, signature, alg) == false) {
 				logger.warn << "JWT verification failed because signature is invalid.\n";
 				return;
 			}
@@ -269,160 +333,25 @@ void Procedure::procedureRun(esl::object::Context& objectContext) {
 	else {
 		authProperties->get()["identified"] = "";
 	}
+
+	/* the verified token is valid until 'exp', but not longer than 'cache-max-ttl' */
+	if(!cacheKey.empty()) {
+		std::time_t expiresAt = currentTime + cacheMaxTtl;
+		if(dropFields.count("exp") == 0 && exp < expiresAt) {
+			expiresAt = exp;
+		}
+		tokenCache->put(cacheKey, TokenCache::Claims{aud, authProperties->get()["identified"]}, expiresAt);
+	}
 }
 
 void Procedure::procedureCancel() {
 }
 
-std::pair<gtx::PublicKey*, std::string> Procedure::getPublicKeyById(const std::string& kid) {
-	if(publicKeyById.count(kid) != 0) {
-		return std::make_pair(publicKeyById.at(kid).first.get(), publicKeyById.at(kid).second);
+std::shared_ptr<const KeyStore::Key> Procedure::getPublicKeyById(const std::string& kid) {
+	if(!keyStore) {
+		return nullptr;
 	}
-
-	for(auto& jwksConnectionFactory : jwksConnectionFactories) {
-		auto connection = jwksConnectionFactory.second.get().createConnection();
-		if(!connection) {
-			logger.warn << "Could not get an connection object for JWKS server with id \"" << jwksConnectionFactory.first << "\".\n";
-			continue;
-		}
-		esl::com::http::client::Request request("", esl::utility::HttpMethod::Type::httpGet, esl::utility::MIME());
-		esl::io::input::String inputString;
-
-		esl::com::http::client::Response response = connection->send(request, esl::io::Output(), esl::io::Input(inputString));
-
-		if(response.getStatusCode() < 200 || response.getStatusCode() > 299) {
-			logger.warn << "JWKS server response with HTTP status code " << response.getStatusCode() << ".\n";
-			continue;
-		}
-
-		rapidjson::Document document;
-		document.Parse(inputString.getString().c_str());
-
-		logger.info << "HTTP response:\n";
-		logger.info << "- content type: " << response.getContentType().toString() << "\n";
-
-		if(!document.IsObject()) {
-			logger.warn << "JWKS content is not a JSON object.\n";
-			continue;
-		}
-
-		if(!document.HasMember("keys") || !document["keys"].IsArray()) {
-			logger.warn << "JWKS object has no \"keys\" array.\n";
-		}
-
-		auto jsonArray = document["keys"].GetArray();
-		for(rapidjson::Value::ConstValueIterator iter = jsonArray.Begin(); iter != jsonArray.End(); ++iter) {
-			if(!iter->IsObject()) {
-				logger.warn << "JWK object has no \"keys\" array.\n";
-				continue;
-			}
-
-			std::string kid;
-			if(iter->HasMember("kid") && (*iter)["kid"].IsString()) {
-				kid = (*iter)["kid"].GetString();
-			}
-
-			if(!iter->HasMember("kty") || !(*iter)["kty"].IsString()) {
-				logger.warn << "JWK object has no string member \"kty\".\n";
-				continue;
-			}
-			std::string kty = (*iter)["kty"].GetString();
-
-			if(kty == "RSA") {
-				std::string use = "sig";
-				if(iter->HasMember("use") && (*iter)["use"].IsString()) {
-					use = (*iter)["use"].GetString();
-				}
-				if(use != "sig") {
-					continue;
-				}
-
-				if(!iter->HasMember("n") || !(*iter)["n"].IsString()) {
-					logger.warn << "JWK object has no string member \"n\".\n";
-					continue;
-				}
-				std::string modulus = esl::utility::String::fromBase64((*iter)["n"].GetString());
-
-				if(!iter->HasMember("e") || !(*iter)["e"].IsString()) {
-					logger.warn << "JWK object has no string member \"e\".\n";
-					continue;
-				}
-				std::string exponent = esl::utility::String::fromBase64((*iter)["e"].GetString());
-
-				std::string alg = "RS256";
-				if(iter->HasMember("alg") && (*iter)["alg"].IsString()) {
-					alg = (*iter)["alg"].GetString();
-				}
-
-				logger.info << "Store public key for KID \"" << kid << "\" with algorithm \"" << alg << "\"\n";
-				publicKeyById.insert(std::make_pair(kid, std::make_pair(gtx::PublicKey::createRSA(exponent, modulus), alg)));
-			}
-			else if(kty == "EC") {
-				std::string use = "sig";
-				if(iter->HasMember("use") && (*iter)["use"].IsString()) {
-					use = (*iter)["use"].GetString();
-				}
-				if(use != "sig") {
-					continue;
-				}
-
-				if(!iter->HasMember("x") || !(*iter)["x"].IsString()) {
-					logger.warn << "JWK object has no string member \"x\".\n";
-					continue;
-				}
-				std::string coordinateX = (*iter)["x"].GetString();
-
-				if(!iter->HasMember("y") || !(*iter)["y"].IsString()) {
-					logger.warn << "JWK object has no string member \"y\".\n";
-					continue;
-				}
-				std::string coordinateY = (*iter)["y"].GetString();
-
-				std::string crv = "P-256";
-				if(iter->HasMember("crv") && (*iter)["crv"].IsString()) {
-					crv = (*iter)["crv"].GetString();
-				}
-
-				gnutls_ecc_curve_t curveType = GNUTLS_ECC_CURVE_INVALID;
-				if(crv == "P-192") {
-					curveType = GNUTLS_ECC_CURVE_SECP192R1;
-				}
-				else if(crv == "P-224") {
-					curveType = GNUTLS_ECC_CURVE_SECP224R1;
-				}
-				else if(crv == "P-256") {
-					curveType = GNUTLS_ECC_CURVE_SECP256R1;
-				}
-				else if(crv == "P-384") {
-					curveType = GNUTLS_ECC_CURVE_SECP384R1;
-				}
-				else if(crv == "P-521") {
-					curveType = GNUTLS_ECC_CURVE_SECP521R1;
-				}
-				else {
-					logger.warn << "JWK object has an unknown EC curve type \"" << crv << "\".\n";
-					continue;
-				}
-
-				std::string alg = "ES256";
-				if(iter->HasMember("alg") && (*iter)["alg"].IsString()) {
-					alg = (*iter)["alg"].GetString();
-				}
-
-				publicKeyById.insert(std::make_pair(kid, std::make_pair(gtx::PublicKey::createEC(curveType, coordinateX, coordinateY), alg)));
-			}
-			else {
-				logger.warn << "Value \"" << kty << "\" of JWK member \"kty\" is not supported. Supported values are \"RSA\" and \"EC\".\n";
-				continue;
-			}
-		}
-
-		if(publicKeyById.count(kid) != 0) {
-			return std::make_pair(publicKeyById.at(kid).first.get(), publicKeyById.at(kid).second);
-		}
-	}
-
-	return std::make_pair(nullptr, "");
+	return keyStore->get(kid);
 }
 
 } /* namespace jwt */
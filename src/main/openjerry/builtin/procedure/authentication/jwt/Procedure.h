@@ -19,6 +19,9 @@
 #ifndef OPENJERRY_BUILTIN_PROCEDURE_AUTHENTICATION_JWT_PROCEDURE_H_
 #define OPENJERRY_BUILTIN_PROCEDURE_AUTHENTICATION_JWT_PROCEDURE_H_
 
+#include <openjerry/builtin/procedure/authentication/jwt/KeyStore.h>
+#include <openjerry/builtin/procedure/authentication/jwt/TokenCache.h>
+
 #include <esl/com/http/client/ConnectionFactory.h>
 #include <esl/crypto/PublicKey.h>
 #include <esl/object/Context.h>
@@ -26,8 +29,9 @@
 #include <esl/object/Procedure.h>
 #include <esl/object/Value.h>
 
-#include <gtx/PublicKey.h>
-
+#include <chrono>
+#include <cstddef>
+#include <ctime>
 #include <functional>
 #include <map>
 #include <memory>
@@ -59,11 +63,21 @@ private:
 	std::set<std::string> dropFields;
 	std::map<std::string, std::string> overrideFields;
 	std::set<std::string> jwksConnectionFactoryIds;
-	std::map<std::string, std::reference_wrapper<esl::com::http::client::ConnectionFactory>> jwksConnectionFactories;
+	KeyStore::ConnectionFactories jwksConnectionFactories;
+
+	/* keys are refreshed in background after 'jwks-refresh-interval' or earlier if the JWKS server sends a
+	 * shorter max-age, an unknown kid fetches the keys again, but not more often than 'jwks-min-fetch-interval' */
+	std::chrono::seconds jwksRefreshInterval{3600};
+	std::chrono::seconds jwksMinFetchInterval{10};
+	std::unique_ptr<KeyStore> keyStore;
 
-	std::map<std::string, std::pair<std::unique_ptr<gtx::PublicKey>, std::string>> publicKeyById;
+	/* optional cache of verified tokens, 'cache-size' is the number of tokens */
+	std::size_t cacheSize = 0;
+	std::size_t cacheShards = 16;
+	std::time_t cacheMaxTtl = 300;
+	std::unique_ptr<TokenCache> tokenCache;
 
-	std::pair<gtx::PublicKey*, std::string> getPublicKeyById(const std::string& kid);
+	std::shared_ptr<const KeyStore::Key> getPublicKeyById(const std::string& kid);
 };
 
 } /* namespace jwt */
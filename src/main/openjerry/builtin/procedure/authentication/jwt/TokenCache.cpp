@@ -0,0 +1,122 @@
+/*
+ * This file is part of Jerry application server.
+ * Copyright (C) 2020-2022 Sven Lukas
+ *
+ * Jerry is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as
+ * published by the Free Software Foundation, either version 3 of
+ * the License, or (at your option) any later version.
+ *
+ * Jerry is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public
+ * License along with Jerry.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include <openjerry/builtin/procedure/authentication/jwt/TokenCache.h>
+
+#include <gnutls/crypto.h>
+#include <gnutls/gnutls.h>
+
+#include <algorithm>
+#include <cstring>
+#include <stdexcept>
+
+namespace openjerry {
+namespace builtin {
+namespace procedure {
+namespace authentication {
+namespace jwt {
+
+TokenCache::TokenCache(std::size_t maxEntries, std::size_t shardCount) {
+	/* there are not more shards than entries and the remainder is distributed, so all shards hold 'maxEntries' exactly */
+	shardCount = std::max<std::size_t>(1, std::min(shardCount, maxEntries));
+	for(std::size_t i = 0; i < shardCount; ++i) {
+		shards.emplace_back(new Shard(maxEntries / shardCount + (i < maxEntries % shardCount ? 1 : 0)));
+	}
+}
+
+std::string TokenCache::createKey(const std::string& data, const std::string& signature) {
+	std::string input;
+	input.reserve(data.size() + 1 + signature.size());
+	input += data;
+	input += '.';
+	input += signature;
+
+	std::string key(32, '\0');
+	if(gnutls_hash_fast(GNUTLS_DIG_SHA256, input.data(), input.size(), &key[0]) < 0) {
+		throw std::runtime_error("Calculation of SHA-256 hash of web token failed");
+	}
+
+	return key;
+}
+
+bool TokenCache::get(const std::string& key, std::time_t currentTime, Claims& claims) {
+	Shard& shard = getShard(key);
+	std::lock_guard<std::mutex> lock(shard.mutex);
+
+	auto iter = shard.nodeByKey.find(key);
+	if(iter == shard.nodeByKey.end()) {
+		misses.fetch_add(1, std::memory_order_relaxed);
+		return false;
+	}
+
+	if(currentTime > iter->second->expiresAt) {
+		shard.nodes.erase(iter->second);
+		shard.nodeByKey.erase(iter);
+		misses.fetch_add(1, std::memory_order_relaxed);
+		return false;
+	}
+
+	shard.nodes.splice(shard.nodes.begin(), shard.nodes, iter->second);
+	claims = iter->second->claims;
+	hits.fetch_add(1, std::memory_order_relaxed);
+	return true;
+}
+
+void TokenCache::put(const std::string& key, const Claims& claims, std::time_t expiresAt) {
+	Shard& shard = getShard(key);
+	std::lock_guard<std::mutex> lock(shard.mutex);
+
+	if(shard.maxEntries == 0) {
+		return;
+	}
+
+	auto iter = shard.nodeByKey.find(key);
+	if(iter != shard.nodeByKey.end()) {
+		shard.nodes.erase(iter->second);
+		shard.nodeByKey.erase(iter);
+	}
+
+	while(!shard.nodes.empty() && shard.nodes.size() >= shard.maxEntries) {
+		shard.nodeByKey.erase(shard.nodes.back().key);
+		shard.nodes.pop_back();
+	}
+
+	shard.nodes.push_front(Node{key, claims, expiresAt});
+	shard.nodeByKey[key] = shard.nodes.begin();
+}
+
+std::uint64_t TokenCache::getHits() const noexcept {
+	return hits.load(std::memory_order_relaxed);
+}
+
+std::uint64_t TokenCache::getMisses() const noexcept {
+	return misses.load(std::memory_order_relaxed);
+}
+
+TokenCache::Shard& TokenCache::getShard(const std::string& key) {
+	/* the key is a cryptographic hash already, so its first bytes are distributed evenly */
+	std::uint64_t value = 0;
+	std::memcpy(&value, key.data(), std::min(sizeof(value), key.size()));
+	return *shards[value % shards.size()];
+}
+
+} /* namespace jwt */
+} /* namespace authentication */
+} /* namespace procedure */
+} /* namespace builtin */
+} /* namespace openjerry */
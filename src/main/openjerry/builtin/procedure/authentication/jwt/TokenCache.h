@@ -0,0 +1,96 @@
+/*
+ * This file is part of Jerry application server.
+ * Copyright (C) 2020-2022 Sven Lukas
+ *
+ * Jerry is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as
+ * published by the Free Software Foundation, either version 3 of
+ * the License, or (at your option) any later version.
+ *
+ * Jerry is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public
+ * License along with Jerry.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#ifndef OPENJERRY_BUILTIN_PROCEDURE_AUTHENTICATION_JWT_TOKENCACHE_H_
+#define OPENJERRY_BUILTIN_PROCEDURE_AUTHENTICATION_JWT_TOKENCACHE_H_
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <ctime>
+#include <list>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+namespace openjerry {
+namespace builtin {
+namespace procedure {
+namespace authentication {
+namespace jwt {
+
+/* Cache of verified web tokens. The key is the SHA-256 hash of data and signature of the token,
+ * so a token has to be verified only once until it expires. The cache is divided into shards
+ * with their own lock and LRU list to avoid a global contention point.
+ */
+class TokenCache {
+public:
+	/* verified claims of a token as they are needed to authenticate a request */
+	struct Claims {
+		std::string aud;
+		std::string identified;
+	};
+
+	TokenCache(std::size_t maxEntries, std::size_t shardCount);
+
+	static std::string createKey(const std::string& data, const std::string& signature);
+
+	/* returns false if there is no entry for 'key' or if the entry has expired at 'currentTime' */
+	bool get(const std::string& key, std::time_t currentTime, Claims& claims);
+	void put(const std::string& key, const Claims& claims, std::time_t expiresAt);
+
+	std::uint64_t getHits() const noexcept;
+	std::uint64_t getMisses() const noexcept;
+
+private:
+	struct Node {
+		std::string key;
+		Claims claims;
+		std::time_t expiresAt;
+	};
+
+	struct Shard {
+		Shard(std::size_t aMaxEntries)
+		: maxEntries(aMaxEntries)
+		{ }
+
+		const std::size_t maxEntries;
+		std::mutex mutex;
+
+		/* most recently used node is at front */
+		std::list<Node> nodes;
+		std::unordered_map<std::string, std::list<Node>::iterator> nodeByKey;
+	};
+
+	std::vector<std::unique_ptr<Shard>> shards;
+
+	std::atomic<std::uint64_t> hits{0};
+	std::atomic<std::uint64_t> misses{0};
+
+	Shard& getShard(const std::string& key);
+};
+
+} /* namespace jwt */
+} /* namespace authentication */
+} /* namespace procedure */
+} /* namespace builtin */
+} /* namespace openjerry */
+
+#endif /* OPENJERRY_BUILTIN_PROCEDURE_AUTHENTICATION_JWT_TOKENCACHE_H_ */
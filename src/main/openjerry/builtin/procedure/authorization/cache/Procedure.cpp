@@ -93,7 +93,8 @@ Procedure::Procedure(const std::vector<std::pair<std::string, std::string>>& set
 				throw std::runtime_error("Value \"0\" of parameter 'lifetime-ms' is invalid");
 			}
 		}
-		else {
+		/* a cached nullptr would skip the authorization, so there is no negative caching */
+		else if(setting.first == "negative-cache-size" || setting.first == "negative-lifetime-ms" || !sessionCacheSettings.addSetting(setting.first, setting.second)) {
 			throw std::runtime_error("Unknown parameter key=\"" + setting.first + "\" with value=\"" + setting.second + "\"");
 		}
 	}
@@ -103,13 +104,21 @@ Procedure::Procedure(const std::vector<std::pair<std::string, std::string>>& set
 	}
 }
 
+Procedure::~Procedure() {
+	if(sessionCache) {
+		logger.info << "Authorization cache: " << sessionCache->getHits() << " hits, " << sessionCache->getMisses() << " misses, " << sessionCache->getCoalesced() << " coalesced, "
+				<< sessionCache->getEvictions() << " evictions, " << sessionCache->getRejections() << " rejections, "
+				<< sessionCache->getEntries() << " entries with " << sessionCache->getBytes() << " bytes\n";
+	}
+}
+
 void Procedure::procedureRun(esl::object::Context& objectContext) {
 	/* we are done just for the case a previous procedure created already an authorization object */
 	if(objectContext.findObject<esl::object::Object>(authorizedObjectId)) {
 		return;
 	}
 
-	/* get the identifier string to lookup for an authorization object in out session pool */
+	/* get the identifier string to lookup for an authorization object in our session cache */
 	Properties* authProperties = objectContext.findObject<Properties>("authenticated");
 	if(!authProperties) {
 		return;
@@ -122,22 +131,22 @@ void Procedure::procedureRun(esl::object::Context& objectContext) {
 	}
 	const std::string& user = iter->second;
 
-	/* lookup for an authorization object in our session pool */
-	auto object = sessionPool->get(user, objectContext);
+	/* lookup for an authorization object in our session cache, concurrent lookups of the same user wait for the first one */
+	std::shared_ptr<const esl::object::Cloneable> object = sessionCache->get(user, objectContext);
 
-	/* we are done if a new authorized object has been created because it would have been created in our object context and a copy was created to store in our session pool */
+	/* we are done if a new authorized object has been created because it would have been created in our object context and a copy was created to store in our session cache */
 	if(objectContext.findObject<esl::object::Object>(authorizedObjectId)) {
 		return;
 	}
 
-	/* if no object has been created then sessionPool-get(...) should have returned the existing object */
+	/* if no object has been created in our object context then sessionCache->get(...) should have returned the existing object */
 	if(!object) {
 		logger.warn << "No authorization object found available for user \"" << user << "\"\n.";
 		return;
 	}
 
-	/* the object should be give back into the session pool, so we have to clone it to put it into our object context */
-	esl::object::Cloneable* authorizedObject = object.get();
+	/* the object is shared by the session cache, so we have to clone it to put it into our object context */
+	const esl::object::Cloneable* authorizedObject = object.get();
 	if(!authorizedObject) {
 		logger.warn << "Authorization object for user \"" << user << "\" is null\n.";
 		return;
@@ -155,9 +164,9 @@ void Procedure::initializeContext(esl::object::Context& objectContext) {
 		throw std::runtime_error("Cannot find procedure with id \"" + authorizingProcedureId + "\"");
 	}
 
-	sessionPool.reset(new SessionPool([this](const esl::object::Context& objectContext) {
+	sessionCache.reset(new SessionCache([this](const esl::object::Context& objectContext) {
 		return createAuthorizationObject(objectContext);
-	}, 10, lifetimeMs, lifetimeRenew, false));
+	}, sessionCacheSettings, lifetimeMs, lifetimeRenew));
 }
 
 std::unique_ptr<esl::object::Cloneable> Procedure::createAuthorizationObject(const esl::object::Context& objectContext) {
@@ -177,7 +186,7 @@ std::unique_ptr<esl::object::Cloneable> Procedure::createAuthorizationObject(con
 	const esl::object::Cloneable* cloneableAuthorizationObjectPtr = dynamic_cast<const esl::object::Cloneable*>(authorizationObjectPtr);
 	if(cloneableAuthorizationObjectPtr == nullptr) {
 		logger.warn << "Authorization object with id \"" + authorizedObjectId + "\" was created, but it is not cloneable.\n";
-		logger.warn << "Cannot store authorization object in session pool.\n";
+		logger.warn << "Cannot store authorization object in session cache.\n";
 		return nullptr;
 	}
 
@@ -19,12 +19,14 @@
 #ifndef OPENJERRY_BUILTIN_PROCEDURE_AUTHORIZATION_CACHE_PROCEDURE_H_
 #define OPENJERRY_BUILTIN_PROCEDURE_AUTHORIZATION_CACHE_PROCEDURE_H_
 
+#include <openjerry/utility/SessionCache.h>
+#include <openjerry/utility/SessionCacheSettings.h>
+
 #include <esl/object/Cloneable.h>
 #include <esl/object/Context.h>
 #include <esl/object/InitializeContext.h>
 #include <esl/object/Procedure.h>
 #include <esl/object/Value.h>
-#include <esl/utility/SessionPool.h>
 
 #include <chrono>
 #include <map>
@@ -45,6 +47,7 @@ public:
 	static std::unique_ptr<esl::object::Procedure> create(const std::vector<std::pair<std::string, std::string>>& settings);
 
 	Procedure(const std::vector<std::pair<std::string, std::string>>& settings);
+	~Procedure();
 
 	void initializeContext(esl::object::Context& objectContext) override;
 
@@ -53,7 +56,7 @@ public:
 
 private:
 	using Properties = esl::object::Value<std::map<std::string, std::string>>;
-	using SessionPool = esl::utility::SessionPool<esl::object::Cloneable, std::string, esl::object::Context>;
+	using SessionCache = utility::SessionCache<esl::object::Cloneable, std::string, esl::object::Context>;
 
 	std::string authorizedObjectId = "authorized";
 	std::string authorizingProcedureId;
@@ -61,7 +64,8 @@ private:
 	std::chrono::milliseconds lifetimeMs = std::chrono::milliseconds(0);
 	bool lifetimeRenew = false;
 
-	std::unique_ptr<SessionPool> sessionPool;
+	utility::SessionCacheSettings sessionCacheSettings;
+	std::unique_ptr<SessionCache> sessionCache;
 
 	std::unique_ptr<esl::object::Cloneable> createAuthorizationObject(const esl::object::Context& objectContext);
 };
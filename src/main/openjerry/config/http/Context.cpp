@@ -35,6 +35,7 @@ Context::Context(const std::string& fileName, const tinyxml2::XMLElement& elemen
 	}
 
 	bool hasInherit = false;
+	bool hasMethods = false;
 
 	for(const tinyxml2::XMLAttribute* attribute = element.FirstAttribute(); attribute != nullptr; attribute = attribute->Next()) {
 		if(std::string(attribute->Name()) == "id") {
@@ -63,6 +64,9 @@ Context::Context(const std::string& fileName, const tinyxml2::XMLElement& elemen
 			if(hasInherit) {
 				throw FilePosition::add(*this, "Attribute 'ref-id' is not allowed together with attribute 'inherit'.");
 			}
+			if(hasMethods) {
+				throw FilePosition::add(*this, "Attribute 'ref-id' is not allowed together with attribute 'methods'.");
+			}
 		}
 		else if(std::string(attribute->Name()) == "inherit") {
 			std::string inheritStr = esl::utility::String::toLower(attribute->Value());
@@ -83,6 +87,21 @@ Context::Context(const std::string& fileName, const tinyxml2::XMLElement& elemen
 				throw FilePosition::add(*this, "Attribute 'inherit' is not allowed together with attribute 'ref-id'.");
 			}
 		}
+		else if(std::string(attribute->Name()) == "methods") {
+			if(hasMethods) {
+				throw FilePosition::add(*this, "Multiple definition of attribute 'methods'");
+			}
+			hasMethods = true;
+			if(refId != "") {
+				throw FilePosition::add(*this, "Attribute 'methods' is not allowed together with attribute 'ref-id'.");
+			}
+			try {
+				methods = engine::http::Methods::fromString(attribute->Value());
+			}
+			catch(const std::exception& e) {
+				throw FilePosition::add(*this, "Invalid value \"" + std::string(attribute->Value()) + "\" for attribute 'methods'. " + e.what());
+			}
+		}
 		else {
 			throw FilePosition::add(*this, "Unknown attribute '" + std::string(attribute->Name()) + "'");
 		}
@@ -114,6 +133,9 @@ void Context::save(std::ostream& oStream, std::size_t spaces) const {
 		else {
 			oStream << " inherit=\"false\"";
 		}
+		if(methods != engine::http::Methods::all) {
+			oStream << " methods=\"" << engine::http::Methods::toString(methods) << "\"";
+		}
 		oStream << ">\n";
 
 		for(const auto& entry : entries) {
@@ -141,6 +163,7 @@ void Context::install(engine::http::Context& engineHttpContext) const {
 		if(inherit) {
 			httpContextRef.setParent(&engineHttpContext);
 		}
+		httpContextRef.setMethods(methods);
 
 		if(id.empty()) {
 			engineHttpContext.addContext(std::move(httpContext));
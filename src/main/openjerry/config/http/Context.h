@@ -24,6 +24,7 @@
 #include <openjerry/config/http/Entry.h>
 #include <openjerry/config/http/Exceptions.h>
 #include <openjerry/engine/http/Context.h>
+#include <openjerry/engine/http/Methods.h>
 
 #include <tinyxml2.h>
 
@@ -55,6 +56,7 @@ private:
 	std::string id;
 	std::string refId;
 	bool inherit = true;
+	engine::http::Methods::Mask methods = engine::http::Methods::all;
 
 	std::vector<Setting> responseHeaders;
 	Exceptions exceptions;
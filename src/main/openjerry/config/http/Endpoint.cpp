@@ -38,6 +38,7 @@ Endpoint::Endpoint(const std::string& fileName, const tinyxml2::XMLElement& elem
 	}
 
 	bool hasInherit = false;
+	bool hasMethods = false;
 
 	for(const tinyxml2::XMLAttribute* attribute = element.FirstAttribute(); attribute != nullptr; attribute = attribute->Next()) {
 		if(std::string(attribute->Name()) == "path") {
@@ -62,6 +63,18 @@ Endpoint::Endpoint(const std::string& fileName, const tinyxml2::XMLElement& elem
 				throw FilePosition::add(*this, "Invalid value \"" + std::string(attribute->Value()) + "\" for attribute 'inherit'");
 			}
 		}
+		else if(std::string(attribute->Name()) == "methods") {
+			if(hasMethods) {
+				throw FilePosition::add(*this, "Multiple definition of attribute 'methods'");
+			}
+			hasMethods = true;
+			try {
+				methods = engine::http::Methods::fromString(attribute->Value());
+			}
+			catch(const std::exception& e) {
+				throw FilePosition::add(*this, "Invalid value \"" + std::string(attribute->Value()) + "\" for attribute 'methods'. " + e.what());
+			}
+		}
 		else {
 			throw FilePosition::add(*this, "Unknown attribute '" + std::string(attribute->Name()) + "'");
 		}
@@ -85,7 +98,11 @@ Endpoint::Endpoint(const std::string& fileName, const tinyxml2::XMLElement& elem
 }
 
 void Endpoint::save(std::ostream& oStream, std::size_t spaces) const {
-	oStream << makeSpaces(spaces) << "<endpoint path=\"" << path << "\">\n";
+	oStream << makeSpaces(spaces) << "<endpoint path=\"" << path << "\"";
+	if(methods != engine::http::Methods::all) {
+		oStream << " methods=\"" << engine::http::Methods::toString(methods) << "\"";
+	}
+	oStream << ">\n";
 
 	for(const auto& entry : entries) {
 		entry->save(oStream, spaces+2);
@@ -107,6 +124,7 @@ void Endpoint::install(engine::http::Context& engineHttpContext) const {
 	if(inherit) {
 		httpEndpointRef.setParent(&engineHttpContext);
 	}
+	httpEndpointRef.setMethods(methods);
 
 	engineHttpContext.addEndpoint(std::move(httpEndpoint));
 
@@ -24,6 +24,7 @@
 #include <openjerry/config/http/Entry.h>
 #include <openjerry/config/http/Exceptions.h>
 #include <openjerry/engine/http/Context.h>
+#include <openjerry/engine/http/Methods.h>
 
 #include <tinyxml2.h>
 
@@ -48,6 +49,7 @@ private:
 	std::string path;
 
 	bool inherit = true;
+	engine::http::Methods::Mask methods = engine::http::Methods::all;
 	std::vector<Setting> responseHeaders;
 	Exceptions exceptions;
 	std::vector<std::unique_ptr<Entry>> entries;
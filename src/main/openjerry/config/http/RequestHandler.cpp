@@ -37,6 +37,8 @@ RequestHandler::RequestHandler(const std::string& fileName, const tinyxml2::XMLE
 		throw FilePosition::add(*this, "Element has user data but it should be empty");
 	}
 
+	bool hasMethods = false;
+
 	for(const tinyxml2::XMLAttribute* attribute = element.FirstAttribute(); attribute != nullptr; attribute = attribute->Next()) {
 		if(std::string(attribute->Name()) == "implementation") {
 			if(!implementation.empty()) {
@@ -47,6 +49,18 @@ RequestHandler::RequestHandler(const std::string& fileName, const tinyxml2::XMLE
 				throw FilePosition::add(*this, "Invalid value \"\" for attribute 'implementation'");
 			}
 		}
+		else if(std::string(attribute->Name()) == "methods") {
+			if(hasMethods) {
+				throw FilePosition::add(*this, "Multiple definition of attribute 'methods'");
+			}
+			hasMethods = true;
+			try {
+				methods = engine::http::Methods::fromString(attribute->Value());
+			}
+			catch(const std::exception& e) {
+				throw FilePosition::add(*this, "Invalid value \"" + std::string(attribute->Value()) + "\" for attribute 'methods'. " + e.what());
+			}
+		}
 		else {
 			throw FilePosition::add(*this, "Unknown attribute '" + std::string(attribute->Name()) + "'");
 		}
@@ -70,7 +84,11 @@ RequestHandler::RequestHandler(const std::string& fileName, const tinyxml2::XMLE
 }
 
 void RequestHandler::save(std::ostream& oStream, std::size_t spaces) const {
-	oStream << makeSpaces(spaces) << "<requesthandler implementation=\"" << implementation << "\">\n";
+	oStream << makeSpaces(spaces) << "<requesthandler implementation=\"" << implementation << "\"";
+	if(methods != engine::http::Methods::all) {
+		oStream << " methods=\"" << engine::http::Methods::toString(methods) << "\"";
+	}
+	oStream << ">\n";
 
 	for(const auto& entry : settings) {
 		entry.saveParameter(oStream, spaces+2);
@@ -81,7 +99,7 @@ void RequestHandler::save(std::ostream& oStream, std::size_t spaces) const {
 
 void RequestHandler::install(engine::http::Context& context) const {
 #if 1
-	context.addRequestHandler(create());
+	context.addRequestHandler(create(), methods);
 #else
 	std::vector<std::pair<std::string, std::string>> eslSettings;
 	for(const auto& setting : settings) {
@@ -22,6 +22,7 @@
 #include <openjerry/config/Config.h>
 #include <openjerry/config/Setting.h>
 #include <openjerry/engine/http/Context.h>
+#include <openjerry/engine/http/Methods.h>
 
 #include <esl/com/http/server/RequestHandler.h>
 
@@ -42,6 +43,7 @@ public:
 
 private:
 	std::string implementation;
+	engine::http::Methods::Mask methods = engine::http::Methods::all;
 	std::vector<Setting> settings;
 
 	std::unique_ptr<esl::com::http::server::RequestHandler> create() const;
@@ -21,6 +21,7 @@
 #include <openjerry/config/http/Exceptions.h>
 #include <openjerry/config/http/EntryImpl.h>
 #include <openjerry/engine/http/Server.h>
+#include <openjerry/utility/Number.h>
 #include <openjerry/Logger.h>
 
 #include <esl/plugin/exception/PluginNotFound.h>
@@ -42,6 +43,9 @@ Server::Server(const std::string& fileName, const tinyxml2::XMLElement& element)
 	}
 
 	bool hasInherit = false;
+	bool hasRouteCacheSize = false;
+	bool hasTraceSampleRate = false;
+	bool hasTraceHeader = false;
 
 	for(const tinyxml2::XMLAttribute* attribute = element.FirstAttribute(); attribute != nullptr; attribute = attribute->Next()) {
 		// 	<http-server implementation="mhd4esl" https="true">
@@ -67,6 +71,40 @@ Server::Server(const std::string& fileName, const tinyxml2::XMLElement& element)
 				throw FilePosition::add(*this, "Invalid value \"" + std::string(attribute->Value()) + "\" for attribute 'inherit'");
 			}
 		}
+		else if(std::string(attribute->Name()) == "route-cache-size") {
+			if(hasRouteCacheSize) {
+				throw FilePosition::add(*this, "Multiple definition of attribute 'route-cache-size'");
+			}
+			hasRouteCacheSize = true;
+			try {
+				routeCacheSize = utility::Number::toNumber(attribute->Name(), attribute->Value());
+			}
+			catch(...) {
+				throw FilePosition::add(*this, "Invalid value \"" + std::string(attribute->Value()) + "\" for attribute 'route-cache-size'");
+			}
+		}
+		else if(std::string(attribute->Name()) == "trace-sample-rate") {
+			if(hasTraceSampleRate) {
+				throw FilePosition::add(*this, "Multiple definition of attribute 'trace-sample-rate'");
+			}
+			hasTraceSampleRate = true;
+			try {
+				traceSampleRate = utility::Number::toNumber(attribute->Name(), attribute->Value());
+			}
+			catch(...) {
+				throw FilePosition::add(*this, "Invalid value \"" + std::string(attribute->Value()) + "\" for attribute 'trace-sample-rate'");
+			}
+		}
+		else if(std::string(attribute->Name()) == "trace-header") {
+			if(hasTraceHeader) {
+				throw FilePosition::add(*this, "Multiple definition of attribute 'trace-header'");
+			}
+			hasTraceHeader = true;
+			traceHeader = attribute->Value();
+			if(traceHeader == "") {
+				throw FilePosition::add(*this, "Invalid value \"\" for attribute 'trace-header'");
+			}
+		}
 		else {
 			throw FilePosition::add(*this, "Unknown attribute '" + std::string(attribute->Name()) + "'");
 			//throw FilePosition::add(*this, "Unknown attribute '" + std::string(attribute->Name()) + "'");
@@ -99,6 +137,18 @@ void Server::save(std::ostream& oStream, std::size_t spaces) const {
 		oStream << " inherit=\"false\"";
 	}
 
+	if(routeCacheSize > 0) {
+		oStream << " route-cache-size=\"" << routeCacheSize << "\"";
+	}
+
+	if(traceSampleRate > 0) {
+		oStream << " trace-sample-rate=\"" << traceSampleRate << "\"";
+	}
+
+	if(!traceHeader.empty()) {
+		oStream << " trace-header=\"" << traceHeader << "\"";
+	}
+
 	oStream << ">\n";
 
 	for(const auto& entry : settings) {
@@ -130,6 +180,9 @@ void Server::install(engine::main::Context& engineMainContext) const {
 
 		std::unique_ptr<engine::http::Server> server(new engine::http::Server(engineMainContext, eslSettings, implementation));
 		engine::http::Server& serverRef = *server;
+		serverRef.setRouteCacheSize(routeCacheSize);
+		serverRef.setTraceSampleRate(traceSampleRate);
+		serverRef.setTraceHeader(traceHeader);
 
 		if(inherit) {
 			serverRef.getContext().ObjectContext::setParent(&engineMainContext);
@@ -48,6 +48,9 @@ private:
 	std::string implementation;
 	std::vector<Setting> settings;
 	bool inherit = true;
+	std::size_t routeCacheSize = 0;
+	std::size_t traceSampleRate = 0;
+	std::string traceHeader;
 	std::vector<Setting> responseHeaders;
 	Exceptions exceptions;
 	std::vector<std::unique_ptr<Entry>> entries;
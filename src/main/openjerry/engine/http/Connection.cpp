@@ -30,28 +30,35 @@ Connection::Connection(RequestContext& aRequestContext, esl::com::http::server::
 { }
 
 bool Connection::send(const esl::com::http::server::Response& aResponse, esl::io::Output output) {
+	const ResponseHeaders* responseHeaders = getResponseHeaders();
+	if(responseHeaders == nullptr) {
+		return baseConnection.send(aResponse, std::move(output));
+	}
+
 	esl::com::http::server::Response response(aResponse);
-	addHeaders(response);
+	responseHeaders->addTo(response);
 	return baseConnection.send(response, std::move(output));
 }
 
 bool Connection::sendFile(const esl::com::http::server::Response& aResponse, const std::string& path) {
+	const ResponseHeaders* responseHeaders = getResponseHeaders();
+	if(responseHeaders == nullptr) {
+		return baseConnection.sendFile(aResponse, path);
+	}
+
 	esl::com::http::server::Response response(aResponse);
-	addHeaders(response);
+	responseHeaders->addTo(response);
 	return baseConnection.sendFile(response, path);
 }
 
-void Connection::addHeaders(esl::com::http::server::Response& response) {
-	if(requestContext.getHeadersContext()) {
-		const std::map<std::string, std::string>& headers = requestContext.getHeadersContext()->getEffectiveHeaders();
-
-		for(const auto& header : headers) {
-			response.addHeader(header.first, header.second);
-		}
+const ResponseHeaders* Connection::getResponseHeaders() const {
+	/* there is no need to copy the response if there are no headers to add */
+	if(requestContext.getHeadersContext() == nullptr || requestContext.getHeadersContext()->getResponseHeaders().empty()) {
+		return nullptr;
 	}
+	return &requestContext.getHeadersContext()->getResponseHeaders();
 }
 
-
 } /* namespace http */
 } /* namespace engine */
 } /* namespace openjerry */
@@ -20,6 +20,7 @@
 #define OPENJERRY_ENGINE_HTTP_CONNECTION_H_
 
 #include <openjerry/engine/http/Context.h>
+#include <openjerry/engine/http/ResponseHeaders.h>
 
 #include <esl/com/http/server/Connection.h>
 #include <esl/com/http/server/Response.h>
@@ -43,7 +44,7 @@ private:
 	RequestContext& requestContext;
 	esl::com::http::server::Connection& baseConnection;
 
-	void addHeaders(esl::com::http::server::Response& response);
+	const ResponseHeaders* getResponseHeaders() const;
 };
 
 
@@ -74,6 +74,7 @@ void Context::addContext(const std::string& refId) {
 	    throw std::runtime_error("No context found with ref-id=\"" + refId + "\".");
 	}
 
+	context->setDispatchRoot();
 	entries.emplace_back(new EntryImpl(*context));
 }
 
@@ -82,15 +83,25 @@ void Context::addContext(std::unique_ptr<Context> context) {
 }
 
 void Context::addEndpoint(std::unique_ptr<Endpoint> endpoint) {
+	endpoints.push_back(std::make_pair(entries.size(), endpoint.get()));
 	entries.emplace_back(new EntryImpl(std::move(endpoint)));
 }
 
 void Context::addHost(std::unique_ptr<Host> host) {
+	hosts.push_back(std::make_pair(entries.size(), host.get()));
 	entries.emplace_back(new EntryImpl(std::move(host)));
 }
 
-void Context::addRequestHandler(std::unique_ptr<esl::com::http::server::RequestHandler> requestHandler) {
-	entries.emplace_back(new EntryImpl(std::move(requestHandler)));
+void Context::addRequestHandler(std::unique_ptr<esl::com::http::server::RequestHandler> requestHandler, Methods::Mask methods) {
+	entries.emplace_back(new EntryImpl(std::move(requestHandler), methods));
+}
+
+void Context::setMethods(Methods::Mask aMethods) {
+	methods = aMethods;
+}
+
+Methods::Mask Context::getMethods() const noexcept {
+	return methods;
 }
 
 void Context::setShowException(Context::OptionalBool aShowException) {
@@ -178,6 +189,14 @@ const std::map<std::string, std::string>& Context::getEffectiveHeaders() const {
 	return headersEffective;
 }
 
+const ResponseHeaders& Context::getResponseHeaders() const {
+	return responseHeaders;
+}
+
+void Context::setDispatchRoot() {
+	dispatchRoot = true;
+}
+
 void Context::initializeContext() {
 	// initialize objects of this context
 	ObjectContext::initializeContext();
@@ -192,14 +211,46 @@ void Context::initializeContext() {
 	else {
 		headersEffective = headers;
 	}
+	responseHeaders = ResponseHeaders(headersEffective);
 
 	// call initializeContext() of sub-context's
 	for(auto& entry : entries) {
 		entry->initializeContext(*this);
 	}
+
+	// build radix trees for runs of consecutive endpoints
+	routers.clear();
+	for(const auto& endpoint : endpoints) {
+		if(routers.empty() || routers.back().getLastIndex() + 1 != endpoint.first) {
+			routers.emplace_back(endpoint.first);
+		}
+		routers.back().addEndpoint(endpoint.second->getPath(), endpoint.first);
+	}
+
+	// build host indexes for runs of consecutive hosts
+	hostIndexes.clear();
+	for(const auto& host : hosts) {
+		if(hostIndexes.empty() || hostIndexes.back().getLastIndex() + 1 != host.first) {
+			hostIndexes.emplace_back(host.first);
+		}
+		hostIndexes.back().addHost(host.second->getServerName(), host.first);
+	}
+
+	// compile the context tree into a flat dispatch plan, if this context is not inlined into the plan of another context
+	if(dispatchRoot) {
+		dispatchPlan.reset(new DispatchPlan);
+		compile(*dispatchPlan);
+	}
 }
 
 void Context::dumpTree(std::size_t depth) const {
+	if(methods != Methods::all) {
+		for(std::size_t i=0; i<depth; ++i) {
+			logger.info << "|   ";
+		}
+		logger.info << "methods: " << Methods::toString(methods) << "\n";
+	}
+
 	if(showException != obEmpty) {
 		for(std::size_t i=0; i<depth; ++i) {
 			logger.info << "|   ";
@@ -281,20 +332,77 @@ void Context::dumpTree(std::size_t depth) const {
 	}
 }
 
-esl::io::Input Context::accept(RequestContext& requestContext) {
-	for(auto& entry : entries) {
-		requestContext.setHeadersContext(this);
-		requestContext.setErrorHandlingContext(this);
+void Context::compile(DispatchPlan& plan) {
+	auto routerIter = routers.begin();
+	auto hostIndexIter = hostIndexes.begin();
+	auto endpointIter = endpoints.begin();
+	auto hostIter = hosts.begin();
 
-		esl::io::Input input = entry->accept(requestContext);
-		if(input) {
-			return input;
+	std::size_t methodCheck = 0;
+	if(methods != Methods::all) {
+		methodCheck = plan.addMethodCheck(methods);
+	}
+
+	for(std::size_t index = 0; index < entries.size(); ++index) {
+		if(routerIter != routers.end() && routerIter->getFirstIndex() == index) {
+			std::vector<std::pair<std::size_t, Endpoint*>> runEndpoints;
+			for(; endpointIter != endpoints.end() && endpointIter->first <= routerIter->getLastIndex(); ++endpointIter) {
+				runEndpoints.push_back(*endpointIter);
+			}
+			plan.addEndpoints(*this, *routerIter, runEndpoints);
+
+			index = routerIter->getLastIndex();
+			++routerIter;
+			continue;
 		}
+
+		if(hostIndexIter != hostIndexes.end() && hostIndexIter->getFirstIndex() == index) {
+			std::vector<std::pair<std::size_t, Host*>> runHosts;
+			for(; hostIter != hosts.end() && hostIter->first <= hostIndexIter->getLastIndex(); ++hostIter) {
+				runHosts.push_back(*hostIter);
+			}
+			plan.addHosts(*this, *hostIndexIter, runHosts);
+
+			index = hostIndexIter->getLastIndex();
+			++hostIndexIter;
+			continue;
+		}
+
+		entries[index]->compile(plan, *this);
 	}
 
-	return esl::io::Input();
+	if(methods != Methods::all) {
+		plan.endMethodCheck(methodCheck);
+	}
 }
 
+esl::io::Input Context::accept(RequestContext& requestContext, RouteCache* routeCache, DispatchTrace* trace) {
+	if(!dispatchPlan) {
+		throw std::runtime_error("Context is dispatched without dispatch plan");
+	}
+	return dispatchPlan->accept(requestContext, routeCache, trace);
+}
+
+void Context::dumpStatistics() const {
+	std::set<const Context*> dumpedContexts;
+	dumpStatistics(dumpedContexts);
+}
+
+void Context::dumpStatistics(std::set<const Context*>& dumpedContexts) const {
+	/* a context can be referenced several times, but its plan is dumped only once */
+	if(!dispatchPlan || !dumpedContexts.insert(this).second) {
+		return;
+	}
+
+	if(dumpedContexts.size() > 1) {
+		logger.info << "Dispatch statistics of referenced context " << this << ":\n";
+	}
+	dispatchPlan->dumpStatistics();
+
+	for(const Context* refContext : dispatchPlan->getRefContexts()) {
+		refContext->dumpStatistics(dumpedContexts);
+	}
+}
 
 } /* namespace http */
 } /* namespace engine */
@@ -20,7 +20,14 @@
 #define OPENJERRY_ENGINE_HTTP_CONTEXT_H_
 
 #include <openjerry/engine/http/Entry.h>
+#include <openjerry/engine/http/DispatchPlan.h>
+#include <openjerry/engine/http/DispatchTrace.h>
 #include <openjerry/engine/http/Document.h>
+#include <openjerry/engine/http/HostIndex.h>
+#include <openjerry/engine/http/Methods.h>
+#include <openjerry/engine/http/ResponseHeaders.h>
+#include <openjerry/engine/http/RouteCache.h>
+#include <openjerry/engine/http/Router.h>
 #include <openjerry/engine/ObjectContext.h>
 #include <openjerry/engine/ProcessRegistry.h>
 
@@ -30,8 +37,10 @@
 
 #include <string>
 #include <map>
+#include <set>
 #include <vector>
 #include <memory>
+#include <utility>
 
 namespace openjerry {
 namespace engine {
@@ -61,7 +70,11 @@ public:
 	void addContext(std::unique_ptr<Context> context);
 	void addEndpoint(std::unique_ptr<Endpoint> endpoint);
 	void addHost(std::unique_ptr<Host> host);
-	void addRequestHandler(std::unique_ptr<esl::com::http::server::RequestHandler> requestHandler);
+	void addRequestHandler(std::unique_ptr<esl::com::http::server::RequestHandler> requestHandler, Methods::Mask methods = Methods::all);
+
+	/* requests with a method not contained in 'methods' are not dispatched into this context */
+	void setMethods(Methods::Mask methods);
+	Methods::Mask getMethods() const noexcept;
 
 	void setShowException(OptionalBool showException);
 	bool getShowException() const;
@@ -78,16 +91,44 @@ public:
 	void addHeader(std::string key, std::string value);
 	const std::map<std::string, std::string>& getHeaders() const;
 	const std::map<std::string, std::string>& getEffectiveHeaders() const;
+	const ResponseHeaders& getResponseHeaders() const;
+
+	/* Only contexts that are dispatched directly, i.e. the root context of a server and contexts
+	 * referenced by id, get their own dispatch plan. All other contexts are inlined into the plan
+	 * of such a context. Has to be called before initializeContext().
+	 */
+	void setDispatchRoot();
 
 	void initializeContext() override;
 	void dumpTree(std::size_t depth) const override;
-	esl::io::Input accept(RequestContext& requestContext);
+
+	/* adds the instructions of this context and its sub-contexts to 'plan' */
+	void compile(DispatchPlan& plan);
+	esl::io::Input accept(RequestContext& requestContext, RouteCache* routeCache = nullptr, DispatchTrace* trace = nullptr);
+	/* dumps the statistics of the plan of this context and of all plans of referenced contexts */
+	void dumpStatistics() const;
 
 private:
 	std::vector<std::unique_ptr<Entry>> entries;
 
+	/* maps entry index to endpoint for all entries that are endpoints */
+	std::vector<std::pair<std::size_t, Endpoint*>> endpoints;
+
+	/* radix trees for each run of consecutive endpoint entries, ordered by index of first entry */
+	std::vector<Router> routers;
+
+	/* maps entry index to host for all entries that are hosts */
+	std::vector<std::pair<std::size_t, Host*>> hosts;
+
+	/* host indexes for each run of consecutive host entries, ordered by index of first entry */
+	std::vector<HostIndex> hostIndexes;
+
+	bool dispatchRoot = false;
+	std::unique_ptr<DispatchPlan> dispatchPlan;
+
 	Context* parent = nullptr;
 	bool followParentOnFind = true;
+	Methods::Mask methods = Methods::all;
 
 	OptionalBool showException = obEmpty;
 	OptionalBool showStacktrace = obEmpty;
@@ -98,6 +139,9 @@ private:
 
 	std::map<std::string, std::string> headers;
 	std::map<std::string, std::string> headersEffective;
+	ResponseHeaders responseHeaders;
+
+	void dumpStatistics(std::set<const Context*>& dumpedContexts) const;
 };
 
 
@@ -0,0 +1,482 @@
+/*
+ * This file is part of Jerry application server.
+ * Copyright (C) 2020-2022 Sven Lukas
+ *
+ * Jerry is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as
+ * published by the Free Software Foundation, either version 3 of
+ * the License, or (at your option) any later version.
+ *
+ * Jerry is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public
+ * License along with Jerry.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include <openjerry/engine/http/DispatchPlan.h>
+#include <openjerry/engine/http/Context.h>
+#include <openjerry/engine/http/Endpoint.h>
+#include <openjerry/engine/http/Host.h>
+#include <openjerry/engine/http/RequestContext.h>
+#include <openjerry/Logger.h>
+
+#include <array>
+#include <bit>
+#include <sstream>
+
+namespace openjerry {
+namespace engine {
+namespace http {
+
+
+namespace {
+Logger logger("openjerry::engine::http::DispatchPlan");
+
+} /* anonymous namespace */
+
+/* stack of path offsets to restore when leaving an endpoint. It does not allocate memory
+ * as long as endpoints are not nested deeper than the size of the inline array.
+ */
+class DispatchPlan::PathOffsetStack {
+public:
+	void push(std::size_t pathOffset) {
+		if(size < inlineOffsets.size()) {
+			inlineOffsets[size] = pathOffset;
+		}
+		else {
+			moreOffsets.push_back(pathOffset);
+		}
+		++size;
+	}
+
+	std::size_t pop() {
+		--size;
+		if(size < inlineOffsets.size()) {
+			return inlineOffsets[size];
+		}
+
+		std::size_t pathOffset = moreOffsets.back();
+		moreOffsets.pop_back();
+		return pathOffset;
+	}
+
+private:
+	std::array<std::size_t, 16> inlineOffsets;
+	std::vector<std::size_t> moreOffsets;
+	std::size_t size = 0;
+};
+
+std::size_t DispatchPlan::Run::next(std::string_view path, std::size_t fromIndex) const {
+	std::size_t index = router->find(path, fromIndex);
+	return index == Router::npos ? end : blockStarts[index - firstIndex];
+}
+
+std::size_t DispatchPlan::Run::next(const std::string& hostName, std::size_t fromIndex) const {
+	std::size_t index = hostIndex->find(hostName, fromIndex);
+	return index == HostIndex::npos ? end : blockStarts[index - firstIndex];
+}
+
+void DispatchPlan::addProcedure(const Context& ownerContext, esl::object::Procedure& procedure) {
+	addInstruction(Kind::procedure, &ownerContext, &procedure);
+}
+
+void DispatchPlan::addContext(const Context& ownerContext, Context& context) {
+	addInstruction(enterContext, &ownerContext, &context);
+	context.compile(*this);
+}
+
+void DispatchPlan::addRefContext(const Context& ownerContext, Context& refContext) {
+	addInstruction(callContext, &ownerContext, &refContext);
+}
+
+void DispatchPlan::addRequestHandler(const Context& ownerContext, esl::com::http::server::RequestHandler& aRequestHandler) {
+	addInstruction(Kind::requestHandler, &ownerContext, &aRequestHandler);
+}
+
+void DispatchPlan::addEndpoints(const Context& ownerContext, const Router& router, const std::vector<std::pair<std::size_t, Endpoint*>>& endpoints) {
+	std::size_t run = runs.size();
+	runs.emplace_back();
+	runs[run].router = &router;
+	runs[run].firstIndex = router.getFirstIndex();
+
+	addInstruction(endpointRun, &ownerContext, nullptr, run);
+
+	for(const auto& endpoint : endpoints) {
+		std::size_t enterInstruction = instructions.size();
+		runs[run].blockStarts.push_back(enterInstruction);
+
+		addInstruction(endpointEnter, &ownerContext, endpoint.second, run, endpoint.first);
+		endpoint.second->compile(*this);
+		instructions[enterInstruction].jump = instructions.size();
+		addInstruction(endpointLeave, nullptr, endpoint.second, run, endpoint.first);
+	}
+
+	runs[run].end = instructions.size();
+}
+
+void DispatchPlan::addHosts(const Context& ownerContext, const HostIndex& hostIndex, const std::vector<std::pair<std::size_t, Host*>>& hosts) {
+	std::size_t run = runs.size();
+	runs.emplace_back();
+	runs[run].hostIndex = &hostIndex;
+	runs[run].firstIndex = hostIndex.getFirstIndex();
+
+	addInstruction(hostRun, &ownerContext, nullptr, run);
+
+	for(const auto& host : hosts) {
+		runs[run].blockStarts.push_back(instructions.size());
+
+		addInstruction(hostEnter, &ownerContext, host.second, run, host.first);
+		host.second->compile(*this);
+		addInstruction(hostLeave, nullptr, host.second, run, host.first);
+	}
+
+	runs[run].end = instructions.size();
+}
+
+std::size_t DispatchPlan::addMethodCheck(Methods::Mask methods) {
+	std::size_t methodCheckInstruction = instructions.size();
+	addInstruction(methodCheck, nullptr, nullptr, 0, methods);
+	return methodCheckInstruction;
+}
+
+void DispatchPlan::endMethodCheck(std::size_t methodCheckInstruction) {
+	instructions[methodCheckInstruction].jump = instructions.size();
+}
+
+std::size_t DispatchPlan::size() const noexcept {
+	return instructions.size();
+}
+
+esl::io::Input DispatchPlan::accept(RequestContext& requestContext, RouteCache* routeCache, DispatchTrace* trace) const {
+	PathOffsetStack pathOffsets;
+
+	if(routeCache == nullptr || trace != nullptr) {
+		return execute(requestContext, pathOffsets, 0, nullptr, trace);
+	}
+
+	const std::string& hostName = requestContext.getRequest().getHostName();
+	const std::string& method = requestContext.getRequest().getMethod().toString();
+	std::string_view path = requestContext.getPathView();
+
+	std::shared_ptr<const RouteCache::Route> route = routeCache->find(hostName, method, path);
+	if(route) {
+		esl::io::Input input = replay(requestContext, pathOffsets, *route);
+		if(input) {
+			return input;
+		}
+
+		/* the request has not been accepted at the end of the cached route anymore, so continue behind it */
+		return execute(requestContext, pathOffsets, route->back().instruction + 1, nullptr, nullptr);
+	}
+
+	RouteCache::Route newRoute;
+	esl::io::Input input = execute(requestContext, pathOffsets, 0, &newRoute, nullptr);
+	if(input) {
+		routeCache->insert(hostName, method, path, std::make_shared<const RouteCache::Route>(std::move(newRoute)));
+	}
+	return input;
+}
+
+esl::io::Input DispatchPlan::execute(RequestContext& requestContext, PathOffsetStack& pathOffsets, std::size_t pc, RouteCache::Route* route, DispatchTrace* trace) const {
+	Methods::Mask method = Methods::getMask(requestContext.getRequest().getMethod());
+
+	while(pc < instructions.size()) {
+		const Instruction& instruction = instructions[pc];
+
+		if(route) {
+			route->push_back(RouteCache::Step{pc, 0});
+		}
+
+		if(instruction.ownerContext) {
+			requestContext.setHeadersContext(instruction.ownerContext);
+			requestContext.setErrorHandlingContext(instruction.ownerContext);
+		}
+
+		switch(instruction.kind) {
+		case Kind::procedure:
+			if(trace) {
+				trace->enter(*this, pc);
+			}
+			static_cast<esl::object::Procedure*>(instruction.target)->procedureRun(requestContext.getObjectContext());
+			if(trace) {
+				trace->leave(DispatchTrace::Result::match);
+			}
+			++pc;
+			break;
+
+		case enterContext:
+			++pc;
+			break;
+
+		case callContext: {
+			if(trace) {
+				trace->enter(*this, pc);
+			}
+			esl::io::Input input = static_cast<Context*>(instruction.target)->accept(requestContext, nullptr, trace);
+			if(input) {
+				return input;
+			}
+			if(trace) {
+				trace->leave(DispatchTrace::Result::miss);
+			}
+			++pc;
+			break;
+		}
+
+		case Kind::requestHandler: {
+			if(trace) {
+				trace->enter(*this, pc);
+			}
+			esl::io::Input input = static_cast<esl::com::http::server::RequestHandler*>(instruction.target)->accept(requestContext);
+			if(input) {
+				return input;
+			}
+			if(trace) {
+				trace->leave(DispatchTrace::Result::miss);
+			}
+			++pc;
+			break;
+		}
+
+		case endpointRun: {
+			const Run& run = runs[instruction.run];
+			pc = run.next(requestContext.getPathView(), run.firstIndex);
+			break;
+		}
+
+		case endpointEnter: {
+			const Endpoint& endpoint = *static_cast<const Endpoint*>(instruction.target);
+			std::size_t pathOffset = requestContext.getPathOffset();
+			std::size_t matchSize = endpoint.getMatch(requestContext.getPathView());
+
+			if(trace) {
+				trace->enter(*this, pc);
+			}
+
+			pathOffsets.push(pathOffset);
+			if(route) {
+				route->back().matchSize = matchSize;
+			}
+			if(matchSize == Endpoint::npos) {
+				/* jump to the leave instruction, it leaves the trace record as miss because the path offset is unchanged */
+				pc = instruction.jump;
+				break;
+			}
+
+			requestContext.setPathOffset(pathOffset + matchSize);
+			++pc;
+			break;
+		}
+
+		case endpointLeave: {
+			std::size_t pathOffset = pathOffsets.pop();
+			if(trace) {
+				trace->leave(requestContext.getPathOffset() == pathOffset ? DispatchTrace::Result::miss : DispatchTrace::Result::match);
+			}
+			requestContext.setPathOffset(pathOffset);
+			pc = runs[instruction.run].next(requestContext.getPathView(), instruction.index + 1);
+			break;
+		}
+
+		case hostRun: {
+			const Run& run = runs[instruction.run];
+			pc = run.next(requestContext.getRequest().getHostName(), run.firstIndex);
+			break;
+		}
+
+		case hostEnter:
+			if(trace) {
+				trace->enter(*this, pc);
+			}
+			++pc;
+			break;
+
+		case hostLeave:
+			if(trace) {
+				trace->leave(DispatchTrace::Result::match);
+			}
+			pc = runs[instruction.run].next(requestContext.getRequest().getHostName(), instruction.index + 1);
+			break;
+
+		case methodCheck:
+			if(instruction.index & method) {
+				++pc;
+			}
+			else {
+				pc = instruction.jump;
+			}
+			break;
+		}
+	}
+
+	return esl::io::Input();
+}
+
+void DispatchPlan::addSample(std::size_t instruction, DispatchTrace::Result result, std::uint64_t ns) const {
+	Statistics& entryStatistics = *statistics[instruction];
+
+	entryStatistics.visits.fetch_add(1, std::memory_order_relaxed);
+	if(result != DispatchTrace::Result::miss) {
+		entryStatistics.matches.fetch_add(1, std::memory_order_relaxed);
+	}
+	if(result == DispatchTrace::Result::accept) {
+		entryStatistics.accepts.fetch_add(1, std::memory_order_relaxed);
+	}
+
+	std::size_t bucket = std::bit_width(ns);
+	if(bucket > 0) {
+		--bucket;
+	}
+	if(bucket >= Statistics::histogramSize) {
+		bucket = Statistics::histogramSize - 1;
+	}
+	entryStatistics.histogram[bucket].fetch_add(1, std::memory_order_relaxed);
+}
+
+void DispatchPlan::dumpStatistics() const {
+	for(std::size_t instruction = 0; instruction < statistics.size(); ++instruction) {
+		const Statistics& entryStatistics = *statistics[instruction];
+		std::uint64_t visits = entryStatistics.visits.load(std::memory_order_relaxed);
+
+		if(visits == 0) {
+			continue;
+		}
+
+		logger.info << getDescription(instruction)
+				<< ": visits=" << visits
+				<< ", matches=" << entryStatistics.matches.load(std::memory_order_relaxed)
+				<< ", accepts=" << entryStatistics.accepts.load(std::memory_order_relaxed)
+				<< ", p50<" << entryStatistics.getPercentile(50) << "ns"
+				<< ", p99<" << entryStatistics.getPercentile(99) << "ns\n";
+	}
+}
+
+std::vector<Context*> DispatchPlan::getRefContexts() const {
+	std::vector<Context*> refContexts;
+	for(const auto& instruction : instructions) {
+		if(instruction.kind == callContext) {
+			refContexts.push_back(static_cast<Context*>(instruction.target));
+		}
+	}
+	return refContexts;
+}
+
+std::string DispatchPlan::getDescription(std::size_t instruction) const {
+	std::stringstream description;
+	const Instruction& entry = instructions[instruction];
+
+	description << "#" << instruction << " ";
+	switch(entry.kind) {
+	case Kind::procedure:
+		description << "procedure " << entry.target;
+		break;
+	case callContext:
+		description << "context " << entry.target;
+		break;
+	case Kind::requestHandler:
+		description << "request handler " << entry.target;
+		break;
+	case endpointEnter:
+	case endpointLeave:
+		description << "endpoint \"" << static_cast<const Endpoint*>(entry.target)->getPath() << "\"";
+		break;
+	case hostEnter:
+	case hostLeave:
+		description << "host \"" << static_cast<const Host*>(entry.target)->getServerName() << "\"";
+		break;
+	default:
+		description << "instruction";
+		break;
+	}
+
+	return description.str();
+}
+
+std::uint64_t DispatchPlan::Statistics::getPercentile(unsigned int percent) const {
+	std::uint64_t total = 0;
+	for(const auto& bucket : histogram) {
+		total += bucket.load(std::memory_order_relaxed);
+	}
+
+	std::uint64_t count = 0;
+	for(std::size_t i = 0; i < histogram.size(); ++i) {
+		count += histogram[i].load(std::memory_order_relaxed);
+		if(count * 100 >= total * percent) {
+			return std::uint64_t(1) << (i + 1);
+		}
+	}
+
+	return std::uint64_t(1) << histogram.size();
+}
+
+esl::io::Input DispatchPlan::replay(RequestContext& requestContext, PathOffsetStack& pathOffsets, const RouteCache::Route& route) const {
+	for(const auto& step : route) {
+		const Instruction& instruction = instructions[step.instruction];
+
+		if(instruction.ownerContext) {
+			requestContext.setHeadersContext(instruction.ownerContext);
+			requestContext.setErrorHandlingContext(instruction.ownerContext);
+		}
+
+		/* procedures, handlers and referenced contexts are executed again, host and endpoint lookups are skipped */
+		switch(instruction.kind) {
+		case Kind::procedure:
+			static_cast<esl::object::Procedure*>(instruction.target)->procedureRun(requestContext.getObjectContext());
+			break;
+
+		case callContext: {
+			esl::io::Input input = static_cast<Context*>(instruction.target)->accept(requestContext);
+			if(input) {
+				return input;
+			}
+			break;
+		}
+
+		case Kind::requestHandler: {
+			esl::io::Input input = static_cast<esl::com::http::server::RequestHandler*>(instruction.target)->accept(requestContext);
+			if(input) {
+				return input;
+			}
+			break;
+		}
+
+		case endpointEnter:
+			pathOffsets.push(requestContext.getPathOffset());
+			if(step.matchSize != Endpoint::npos) {
+				requestContext.setPathOffset(requestContext.getPathOffset() + step.matchSize);
+			}
+			break;
+
+		case endpointLeave:
+			requestContext.setPathOffset(pathOffsets.pop());
+			break;
+
+		default:
+			break;
+		}
+	}
+
+	return esl::io::Input();
+}
+
+void DispatchPlan::addInstruction(Kind kind, const Context* ownerContext, void* target, std::size_t run, std::size_t index) {
+	Instruction instruction;
+
+	instruction.kind = kind;
+	instruction.ownerContext = ownerContext;
+	instruction.target = target;
+	instruction.run = run;
+	instruction.index = index;
+	instruction.jump = 0;
+
+	instructions.push_back(instruction);
+	statistics.emplace_back(new Statistics);
+}
+
+
+} /* namespace http */
+} /* namespace engine */
+} /* namespace openjerry */
@@ -0,0 +1,161 @@
+/*
+ * This file is part of Jerry application server.
+ * Copyright (C) 2020-2022 Sven Lukas
+ *
+ * Jerry is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as
+ * published by the Free Software Foundation, either version 3 of
+ * the License, or (at your option) any later version.
+ *
+ * Jerry is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public
+ * License along with Jerry.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#ifndef OPENJERRY_ENGINE_HTTP_DISPATCHPLAN_H_
+#define OPENJERRY_ENGINE_HTTP_DISPATCHPLAN_H_
+
+#include <openjerry/engine/http/DispatchTrace.h>
+#include <openjerry/engine/http/HostIndex.h>
+#include <openjerry/engine/http/Methods.h>
+#include <openjerry/engine/http/Router.h>
+#include <openjerry/engine/http/RouteCache.h>
+
+#include <esl/com/http/server/RequestHandler.h>
+#include <esl/io/Input.h>
+#include <esl/object/Procedure.h>
+
+#include <array>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <string_view>
+#include <utility>
+#include <vector>
+
+namespace openjerry {
+namespace engine {
+namespace http {
+
+class Context;
+class Endpoint;
+class Host;
+class RequestContext;
+
+/* Context tree compiled into a flat array of instructions (kind, target, jump-on-miss).
+ * Sub-contexts, hosts and endpoints are inlined into the array, so accept() interprets
+ * the whole tree in one loop. Referenced contexts are called with their own plan.
+ */
+class DispatchPlan {
+public:
+	void addProcedure(const Context& ownerContext, esl::object::Procedure& procedure);
+	void addContext(const Context& ownerContext, Context& context);
+	void addRefContext(const Context& ownerContext, Context& refContext);
+	void addRequestHandler(const Context& ownerContext, esl::com::http::server::RequestHandler& requestHandler);
+	void addEndpoints(const Context& ownerContext, const Router& router, const std::vector<std::pair<std::size_t, Endpoint*>>& endpoints);
+	void addHosts(const Context& ownerContext, const HostIndex& hostIndex, const std::vector<std::pair<std::size_t, Host*>>& hosts);
+
+	/* instructions added between addMethodCheck() and endMethodCheck() are skipped if the request method is not in 'methods' */
+	std::size_t addMethodCheck(Methods::Mask methods);
+	void endMethodCheck(std::size_t methodCheck);
+
+	std::size_t size() const noexcept;
+
+	/* if 'routeCache' is not nullptr, accepted routes are stored in and replayed from it.
+	 * If 'trace' is not nullptr, the route cache is not used and every visited entry is recorded.
+	 */
+	esl::io::Input accept(RequestContext& requestContext, RouteCache* routeCache = nullptr, DispatchTrace* trace = nullptr) const;
+
+	/* statistics of entries collected from sampled requests */
+	void addSample(std::size_t instruction, DispatchTrace::Result result, std::uint64_t ns) const;
+	void dumpStatistics() const;
+	std::string getDescription(std::size_t instruction) const;
+
+	/* contexts called with their own plan */
+	std::vector<Context*> getRefContexts() const;
+
+private:
+	enum Kind {
+		procedure,
+		enterContext,
+		callContext,
+		requestHandler,
+		endpointRun,
+		endpointEnter,
+		endpointLeave,
+		hostRun,
+		hostEnter,
+		hostLeave,
+		methodCheck
+	};
+
+	struct Instruction {
+		Kind kind;
+
+		/* context to set as headers and error handling context before execution or nullptr */
+		const Context* ownerContext;
+
+		void* target;
+
+		/* index of the run and entry index of endpoints and hosts or method mask of a method check */
+		std::size_t run;
+		std::size_t index;
+
+		/* instruction to continue with if an endpoint or method check does not match */
+		std::size_t jump;
+	};
+
+	/* run of consecutive endpoint or host entries of a context */
+	struct Run {
+		const Router* router = nullptr;
+		const HostIndex* hostIndex = nullptr;
+		std::size_t firstIndex = 0;
+
+		/* first instruction of the block of each entry of this run */
+		std::vector<std::size_t> blockStarts;
+
+		/* first instruction behind this run */
+		std::size_t end = 0;
+
+		std::size_t next(std::string_view path, std::size_t fromIndex) const;
+		std::size_t next(const std::string& hostName, std::size_t fromIndex) const;
+	};
+
+	struct Statistics {
+		static constexpr std::size_t histogramSize = 32;
+
+		std::atomic<std::uint64_t> visits{0};
+		std::atomic<std::uint64_t> matches{0};
+		std::atomic<std::uint64_t> accepts{0};
+
+		/* bucket i counts samples with less than 2^(i+1) ns */
+		std::array<std::atomic<std::uint64_t>, histogramSize> histogram{};
+
+		std::uint64_t getPercentile(unsigned int percent) const;
+	};
+
+	class PathOffsetStack;
+
+	std::vector<Instruction> instructions;
+	std::vector<Run> runs;
+
+	/* one entry per instruction */
+	std::vector<std::unique_ptr<Statistics>> statistics;
+
+	esl::io::Input execute(RequestContext& requestContext, PathOffsetStack& pathOffsets, std::size_t pc, RouteCache::Route* route, DispatchTrace* trace) const;
+	esl::io::Input replay(RequestContext& requestContext, PathOffsetStack& pathOffsets, const RouteCache::Route& route) const;
+	void addInstruction(Kind kind, const Context* ownerContext, void* target, std::size_t run = 0, std::size_t index = 0);
+};
+
+
+} /* namespace http */
+} /* namespace engine */
+} /* namespace openjerry */
+
+#endif /* OPENJERRY_ENGINE_HTTP_DISPATCHPLAN_H_ */
@@ -0,0 +1,93 @@
+/*
+ * This file is part of Jerry application server.
+ * Copyright (C) 2020-2022 Sven Lukas
+ *
+ * Jerry is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as
+ * published by the Free Software Foundation, either version 3 of
+ * the License, or (at your option) any later version.
+ *
+ * Jerry is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public
+ * License along with Jerry.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include <openjerry/engine/http/DispatchTrace.h>
+#include <openjerry/engine/http/DispatchPlan.h>
+
+namespace openjerry {
+namespace engine {
+namespace http {
+
+
+namespace {
+constexpr std::size_t npos = static_cast<std::size_t>(-1);
+} /* anonymous namespace */
+
+void DispatchTrace::enter(const DispatchPlan& plan, std::size_t instruction) {
+	std::size_t record = npos;
+
+	if(recordsSize < records.size()) {
+		record = recordsSize++;
+		records[record].plan = &plan;
+		records[record].instruction = instruction;
+		records[record].depth = depth;
+		records[record].result = Result::miss;
+		records[record].ns = 0;
+	}
+	else {
+		++dropped;
+	}
+
+	if(depth < maxDepth) {
+		openRecords[depth] = record;
+		openTimes[depth] = std::chrono::steady_clock::now();
+	}
+	++depth;
+}
+
+void DispatchTrace::leave(Result result) {
+	if(depth == 0) {
+		return;
+	}
+	--depth;
+
+	if(depth < maxDepth && openRecords[depth] != npos) {
+		Record& record = records[openRecords[depth]];
+		record.result = result;
+		record.ns = static_cast<std::uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - openTimes[depth]).count());
+	}
+}
+
+void DispatchTrace::finish(bool accepted) {
+	while(depth > 0) {
+		leave(accepted ? Result::accept : Result::match);
+	}
+}
+
+void DispatchTrace::aggregate() const {
+	for(std::size_t i = 0; i < recordsSize; ++i) {
+		records[i].plan->addSample(records[i].instruction, records[i].result, records[i].ns);
+	}
+}
+
+std::size_t DispatchTrace::size() const noexcept {
+	return recordsSize;
+}
+
+const DispatchTrace::Record& DispatchTrace::operator[](std::size_t index) const noexcept {
+	return records[index];
+}
+
+std::size_t DispatchTrace::getDropped() const noexcept {
+	return dropped;
+}
+
+
+} /* namespace http */
+} /* namespace engine */
+} /* namespace openjerry */
@@ -0,0 +1,88 @@
+/*
+ * This file is part of Jerry application server.
+ * Copyright (C) 2020-2022 Sven Lukas
+ *
+ * Jerry is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as
+ * published by the Free Software Foundation, either version 3 of
+ * the License, or (at your option) any later version.
+ *
+ * Jerry is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public
+ * License along with Jerry.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#ifndef OPENJERRY_ENGINE_HTTP_DISPATCHTRACE_H_
+#define OPENJERRY_ENGINE_HTTP_DISPATCHTRACE_H_
+
+#include <array>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+
+namespace openjerry {
+namespace engine {
+namespace http {
+
+
+class DispatchPlan;
+
+/* Trace of a single sampled request. It records each visited entry of the dispatch plans
+ * with its result and elapsed time into a fixed buffer, so tracing does not allocate memory.
+ * Entries are entered and left nested, the time of a host or endpoint includes its content.
+ */
+class DispatchTrace {
+public:
+	enum class Result : std::uint8_t {
+		miss,
+		match,
+		accept
+	};
+
+	struct Record {
+		const DispatchPlan* plan;
+		std::size_t instruction;
+		std::size_t depth;
+		Result result;
+		std::uint64_t ns;
+	};
+
+	static constexpr std::size_t maxRecords = 256;
+	static constexpr std::size_t maxDepth = 64;
+
+	void enter(const DispatchPlan& plan, std::size_t instruction);
+	void leave(Result result);
+
+	/* leaves all entries that are still entered, they have accepted the request if 'accepted' is true */
+	void finish(bool accepted);
+
+	/* adds all records to the statistics of their dispatch plans */
+	void aggregate() const;
+
+	std::size_t size() const noexcept;
+	const Record& operator[](std::size_t index) const noexcept;
+
+	/* number of records that did not fit into the buffer */
+	std::size_t getDropped() const noexcept;
+
+private:
+	std::array<Record, maxRecords> records;
+	std::size_t recordsSize = 0;
+	std::size_t dropped = 0;
+
+	/* index of the record and start time of each entered entry */
+	std::array<std::size_t, maxDepth> openRecords;
+	std::array<std::chrono::steady_clock::time_point, maxDepth> openTimes;
+	std::size_t depth = 0;
+};
+
+
+} /* namespace http */
+} /* namespace engine */
+} /* namespace openjerry */
+
+#endif /* OPENJERRY_ENGINE_HTTP_DISPATCHTRACE_H_ */
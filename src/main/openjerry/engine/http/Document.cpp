@@ -18,6 +18,12 @@
 
 #include <openjerry/engine/http/Document.h>
 
+#include <esl/utility/Protocol.h>
+#include <esl/utility/URL.h>
+
+#include <filesystem>
+#include <system_error>
+
 namespace openjerry {
 namespace engine {
 namespace http {
@@ -25,12 +31,24 @@ namespace http {
 
 Document::Document(std::string aPath)
 : path(std::move(aPath))
-{ }
+{
+	/* a relative path is resolved once, so the file cache of error documents can watch its directory */
+	esl::utility::URL url(path);
+	if((!url.getScheme() || url.getScheme() == esl::utility::Protocol::Type::file) && !url.getPath().empty()) {
+		std::error_code errorCode;
+		std::filesystem::path absolutePath = std::filesystem::absolute(url.getPath(), errorCode);
+		filePath = errorCode ? url.getPath() : absolutePath.lexically_normal().generic_string();
+	}
+}
 
 const std::string& Document::getPath() const noexcept {
 	return path;
 }
 
+const std::string& Document::getFilePath() const noexcept {
+	return filePath;
+}
+
 void Document::setLanguage(Language language) {
 	switch(language) {
 	case builtinScript:
@@ -37,12 +37,16 @@ public:
 
 	const std::string& getPath() const noexcept;
 
+	/* absolute path of a local document, it is empty if the document is not a local file */
+	const std::string& getFilePath() const noexcept;
+
 	void setLanguage(Language language);
 	void setLanguage(std::string language);
 	const std::string& getLanguage() const noexcept;
 
 private:
 	std::string path;
+	std::string filePath;
 	std::string language;
 };
 
@@ -48,48 +48,30 @@ const std::string& Endpoint::getPath() const noexcept {
 	return path;
 }
 
-const char* Endpoint::getMatch(const std::string& currentPath) const {
-	if(currentPath.empty()) {
-		return nullptr;
+std::size_t Endpoint::getMatch(std::string_view currentPath) const {
+	/* skip leading slashes */
+	std::size_t pos = currentPath.find_first_not_of('/');
+	if(pos == std::string_view::npos || getPath().empty()) {
+		return npos;
 	}
 
-	const char* currentPathCStr = currentPath.c_str();
-	std::size_t currentPathSize = currentPath.size();
-#if 1
-	while(/*currentPathSize > 0 && */currentPathCStr[0] == '/') {
-		++currentPathCStr;
-		--currentPathSize;
-
-	}
-	if(currentPath.find(getPath()) != currentPath.size() - currentPathSize) {
-		return nullptr;
+	if(currentPath.compare(pos, getPath().size(), getPath()) != 0) {
+		return npos;
 	}
-#else
-	if(currentPathCStr[0] == '/') {
-		++currentPathCStr;
-		--currentPathSize;
+	pos += getPath().size();
 
-		if(currentPath.find(getPath()) != 1) {
-			return nullptr;
-		}
-	}
-	else {
-		if(currentPath.find(getPath()) != 0) {
-			return nullptr;
-		}
-	}
-#endif
-	if(currentPathSize == getPath().size()) {
-		return "";
+	if(pos == currentPath.size()) {
+		return pos;
 	}
-	if(/*currentPath.size() > getPath().size() && */currentPathCStr[getPath().size()] != '/') {
-		return nullptr;
+	if(currentPath[pos] != '/') {
+		return npos;
 	}
 
-	if(currentPathSize == getPath().size() + 1) {
-		return &currentPathCStr[getPath().size()];
+	/* keep a trailing slash as sub path "/", otherwise skip the separating slash */
+	if(pos + 1 == currentPath.size()) {
+		return pos;
 	}
-	return &currentPathCStr[getPath().size() + 1];
+	return pos + 1;
 }
 
 #if 0
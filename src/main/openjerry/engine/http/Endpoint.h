@@ -22,7 +22,9 @@
 #include <openjerry/engine/http/Context.h>
 #include <openjerry/engine/ProcessRegistry.h>
 
+#include <cstddef>
 #include <string>
+#include <string_view>
 
 namespace openjerry {
 namespace engine {
@@ -34,8 +36,12 @@ public:
 
 	void dumpTree(std::size_t depth) const override;
 
+	static constexpr std::size_t npos = static_cast<std::size_t>(-1);
+
 	const std::string& getPath() const noexcept;
-	const char* getMatch(const std::string& currentPath) const;
+
+	/* returns the number of characters of 'currentPath' consumed by this endpoint or npos if it does not match */
+	std::size_t getMatch(std::string_view currentPath) const;
 #if 0
 	bool isMatch(const std::string& currentPath) const;
 	std::string getMatchingSubPath(const std::string& currentPath) const;
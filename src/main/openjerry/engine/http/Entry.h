@@ -19,16 +19,14 @@
 #ifndef OPENJERRY_ENGINE_HTTP_ENTRY_H_
 #define OPENJERRY_ENGINE_HTTP_ENTRY_H_
 
-#include <esl/io/Input.h>
-
-#include <string>
+#include <cstddef>
 
 namespace openjerry {
 namespace engine {
 namespace http {
 
 class Context;
-class RequestContext;
+class DispatchPlan;
 
 class Entry {
 public:
@@ -36,7 +34,7 @@ public:
 
 	virtual void initializeContext(Context& ownerContext) = 0;
 	virtual void dumpTree(std::size_t depth) const = 0;
-	virtual esl::io::Input accept(RequestContext& requestContext) = 0;
+	virtual void compile(DispatchPlan& plan, Context& ownerContext) = 0;
 };
 
 
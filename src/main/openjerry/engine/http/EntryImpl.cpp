@@ -54,8 +54,9 @@ EntryImpl::EntryImpl(std::unique_ptr<Host> aHost)
 : host(std::move(aHost))
 { }
 
-EntryImpl::EntryImpl(std::unique_ptr<esl::com::http::server::RequestHandler> aRequestHandler)
-: requestHandler(std::move(aRequestHandler))
+EntryImpl::EntryImpl(std::unique_ptr<esl::com::http::server::RequestHandler> aRequestHandler, Methods::Mask aRequestHandlerMethods)
+: requestHandler(std::move(aRequestHandler)),
+  requestHandlerMethods(aRequestHandlerMethods)
 { }
 
 void EntryImpl::initializeContext(Context& ownerContext) {
@@ -172,119 +173,46 @@ void EntryImpl::dumpTree(std::size_t depth) const {
 		for(std::size_t i=0; i<depth; ++i) {
 			logger.info << "|   ";
 		}
-		logger.info << "+-> RequestHandler: -> " << requestHandler.get() << "\n";
+		logger.info << "+-> RequestHandler: -> " << requestHandler.get();
+		if(requestHandlerMethods != Methods::all) {
+			logger.info << " (methods: " << Methods::toString(requestHandlerMethods) << ")";
+		}
+		logger.info << "\n";
 	}
 }
 
-esl::io::Input EntryImpl::accept(RequestContext& requestContext) {
+void EntryImpl::compile(DispatchPlan& plan, Context& ownerContext) {
+	/* hosts and endpoints are compiled by the owner context, because consecutive
+	 * hosts and endpoints are dispatched together through a host index or router.
+	 */
 	if(procedure) {
-		/* **************** *
-		 * handle procedure *
-		 * **************** */
-		procedure->procedureRun(requestContext.getObjectContext());
+		plan.addProcedure(ownerContext, *procedure);
 	}
 
 	if(refProcedure) {
-		/* *************************** *
-		 * handle referenced procedure *
-		 * *************************** */
-		refProcedure->procedureRun(requestContext.getObjectContext());
+		plan.addProcedure(ownerContext, *refProcedure);
 	}
 
 	if(context) {
-		/* *************** *
-		 * handle context *
-		 * *************** */
-		esl::io::Input input = context->accept(requestContext);
-		if(input) {
-			return input;
-		}
+		plan.addContext(ownerContext, *context);
 	}
 
 	if(refContext) {
-		/* ************************* *
-		 * handle referenced context *
-		 * ************************* */
-		esl::io::Input input = refContext->accept(requestContext);
-		if(input) {
-			return input;
-		}
+		plan.addRefContext(ownerContext, *refContext);
 	}
 
-	if(host && host->isMatch(requestContext.getRequest().getHostName())) {
-		/* *********** *
-		 * handle host *
-		 * *********** */
-		esl::io::Input input = host->accept(requestContext);
-		if(input) {
-			return input;
-		}
-	}
-
-#if 1
-	if(endpoint) {
-		logger.trace << "Check if endpoint '" << endpoint->getPath() << "' matches request path '" << requestContext.getPath() << "'\n";
-		const char* subPath = endpoint->getMatch(requestContext.getPath());
-		if(subPath) {
-			logger.trace << "Match!\n";
-			/* *************** *
-			 * handle endpoint *
-			 * *************** */
-			std::string path = requestContext.getPath();
-
-			requestContext.setPath(subPath);
-			//requestContext.setPath(path.substr(endpoint->getPath().size()));
-			logger.trace << "-> new request path is '" << requestContext.getPath() << "'\n";
-
-			esl::io::Input input = endpoint->accept(requestContext);
-			if(input) {
-				logger.trace << "Request accepted by endpoint '" << endpoint->getPath() << "'\n";
-				return input;
-			}
-
-			requestContext.setPath(path);
-			logger.trace << "Request not accepted by endpoint '" << endpoint->getPath() << "' -> reset path to '" << requestContext.getPath() << "'\n";
-		}
-		else if(logger.trace) {
-			logger.trace << "No match!\n";
-		}
-	}
-#else
-	if(endpoint && endpoint->isMatch(requestContext.getPath())) {
-		logger.trace << "Request path '" << requestContext.getPath() << "' is matching endpoint with path '" << endpoint->getPath() << "'\n";
-		/* *************** *
-		 * handle endpoint *
-		 * *************** */
-		std::string path = requestContext.getPath();
-
-		requestContext.setPath(endpoint->getMatchingSubPath(path));
-		//requestContext.setPath(path.substr(endpoint->getPath().size()));
-		logger.trace << "-> new request path is '" << requestContext.getPath() << "'\n";
-
-		esl::io::Input input = endpoint->accept(requestContext);
-		if(input) {
-			logger.trace << "Request accepted by endpoint '" << endpoint->getPath() << "'\n";
-			return input;
-		}
-
-		requestContext.setPath(path);
-		logger.trace << "Request not accepted by endpoint '" << endpoint->getPath() << "' -> reset path to '" << requestContext.getPath() << "'\n";
-	}
-#endif
 	if(requestHandler) {
-		/* ********************** *
-		 * handle request handler *
-		 * ********************** */
-		esl::io::Input input = requestHandler->accept(requestContext);
-		if(input) {
-			return input;
+		if(requestHandlerMethods == Methods::all) {
+			plan.addRequestHandler(ownerContext, *requestHandler);
+		}
+		else {
+			std::size_t methodCheck = plan.addMethodCheck(requestHandlerMethods);
+			plan.addRequestHandler(ownerContext, *requestHandler);
+			plan.endMethodCheck(methodCheck);
 		}
 	}
-
-	return esl::io::Input();
 }
 
-
 } /* namespace http */
 } /* namespace engine */
 } /* namespace openjerry */
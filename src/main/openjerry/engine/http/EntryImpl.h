@@ -20,13 +20,13 @@
 #define OPENJERRY_ENGINE_HTTP_ENTRYIMPL_H_
 
 #include <openjerry/engine/http/Entry.h>
+#include <openjerry/engine/http/DispatchPlan.h>
 #include <openjerry/engine/http/Context.h>
 #include <openjerry/engine/http/Endpoint.h>
 #include <openjerry/engine/http/Host.h>
-#include <openjerry/engine/http/RequestContext.h>
+#include <openjerry/engine/http/Methods.h>
 
 #include <esl/com/http/server/RequestHandler.h>
-#include <esl/io/Input.h>
 #include <esl/object/Procedure.h>
 
 #include <string>
@@ -45,11 +45,11 @@ public:
 	EntryImpl(Context& refContext);
 	EntryImpl(std::unique_ptr<Endpoint> endpoint);
 	EntryImpl(std::unique_ptr<Host> host);
-	EntryImpl(std::unique_ptr<esl::com::http::server::RequestHandler> requestHandler);
+	EntryImpl(std::unique_ptr<esl::com::http::server::RequestHandler> requestHandler, Methods::Mask requestHandlerMethods = Methods::all);
 
 	void initializeContext(Context& ownerContext) override;
 	void dumpTree(std::size_t depth) const override;
-	esl::io::Input accept(RequestContext& requestContext) override;
+	void compile(DispatchPlan& plan, Context& ownerContext) override;
 
 private:
 	std::unique_ptr<esl::object::Procedure> procedure;
@@ -62,6 +62,7 @@ private:
 	std::unique_ptr<Host> host;
 
 	std::unique_ptr<esl::com::http::server::RequestHandler> requestHandler;
+	Methods::Mask requestHandlerMethods = Methods::all;
 };
 
 
@@ -19,6 +19,8 @@
 #include <openjerry/engine/http/ExceptionHandler.h>
 #include <openjerry/html/HTML.h>
 #include <openjerry/http/StatusCode.h>
+#include <openjerry/utility/ContentProducer.h>
+#include <openjerry/utility/FileCache.h>
 #include <openjerry/utility/MIME.h>
 #include <openjerry/Logger.h>
 
@@ -53,6 +55,15 @@ const std::string PAGE_301(
 		"<h1>301</h1>\n"
 		"</body>\n"
 		"</html>\n");
+
+/* error documents are sent often and rarely changed, so their contents are kept in memory.
+ * They are not mapped, because a file that is rewritten in place while it is sent from a
+ * mapping raises SIGBUS.
+ */
+utility::FileCache& getErrorDocuments() {
+	static utility::FileCache fileCache(16 * 1024 * 1024, 1024 * 1024);
+	return fileCache;
+}
 } /* anonymous namespace */
 
 ExceptionHandler::ExceptionHandler(std::exception_ptr exceptionPointer)
@@ -80,7 +91,14 @@ void ExceptionHandler::dumpHttp(esl::com::http::server::Connection& connection,
 			if(errorDocument->getLanguage().empty()) {
 				esl::com::http::server::Response response(httpStatusCode, utility::MIME::byFilename(url.getPath()));
 				addHeaders(response, headersContext);
-				connection.sendFile(response, url.getPath());
+
+				std::shared_ptr<const utility::FileCache::Entry> entry = getErrorDocuments().get(errorDocument->getFilePath());
+				if(entry->content) {
+					connection.send(response, utility::ContentProducer::create(entry->content));
+				}
+				else {
+					connection.sendFile(response, errorDocument->getFilePath());
+				}
 
 				return;
 			}
@@ -285,10 +303,7 @@ std::string ExceptionHandler::getTextContent(bool showException, bool showStackt
 
 void ExceptionHandler::addHeaders(esl::com::http::server::Response& response, const Context* headersContext) const {
 	if(headersContext) {
-		const std::map<std::string, std::string>& headers = headersContext->getEffectiveHeaders();
-		for(const auto& header : headers) {
-			response.addHeader(header.first, header.second);
-		}
+		headersContext->getResponseHeaders().addTo(response);
 	}
 }
 
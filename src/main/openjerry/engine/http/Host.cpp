@@ -50,18 +50,18 @@ bool Host::isMatch(const std::string& hostName) const {
 		return true;
 	}
 
-	std::string newHostName = hostName;
-	for(std::string::size_type pos = newHostName.find_first_of('.'); pos != std::string::npos ; pos = newHostName.find_first_of('.')) {
-		newHostName = newHostName.substr(pos+1);
-		logger.debug << "Lookup for server-name \"*." << newHostName << "\"\n";
-		if("*." + newHostName == serverName) {
-			return true;
-		}
-	};
+	/* server name "*.<suffix>" matches every host name "<label>.<suffix>" */
+	if(serverName.size() < 2 || serverName[0] != '*' || serverName[1] != '.') {
+		return false;
+	}
 
-	return false;
-}
+	std::string::size_type suffixSize = serverName.size() - 2;
+	if(hostName.size() <= suffixSize || hostName[hostName.size() - suffixSize - 1] != '.') {
+		return false;
+	}
 
+	return hostName.compare(hostName.size() - suffixSize, suffixSize, serverName, 2, suffixSize) == 0;
+}
 
 } /* namespace http */
 } /* namespace engine */
@@ -0,0 +1,130 @@
+/*
+ * This file is part of Jerry application server.
+ * Copyright (C) 2020-2022 Sven Lukas
+ *
+ * Jerry is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as
+ * published by the Free Software Foundation, either version 3 of
+ * the License, or (at your option) any later version.
+ *
+ * Jerry is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public
+ * License along with Jerry.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include <openjerry/engine/http/HostIndex.h>
+
+#include <algorithm>
+#include <string_view>
+
+namespace openjerry {
+namespace engine {
+namespace http {
+
+
+namespace {
+void findIndex(const std::vector<std::size_t>& indexes, std::size_t fromIndex, std::size_t& result) {
+	auto iter = std::lower_bound(indexes.begin(), indexes.end(), fromIndex);
+	if(iter != indexes.end() && *iter < result) {
+		result = *iter;
+	}
+}
+} /* anonymous namespace */
+
+HostIndex::HostIndex(std::size_t aFirstIndex)
+: firstIndex(aFirstIndex),
+  lastIndex(aFirstIndex)
+{ }
+
+std::size_t HostIndex::getFirstIndex() const noexcept {
+	return firstIndex;
+}
+
+std::size_t HostIndex::getLastIndex() const noexcept {
+	return lastIndex;
+}
+
+void HostIndex::addHost(const std::string& serverName, std::size_t index) {
+	if(index > lastIndex) {
+		lastIndex = index;
+	}
+
+	/* entries are added in order of their index, so all index lists stay sorted */
+	if(serverName == "*") {
+		anyIndexes.push_back(index);
+		return;
+	}
+
+	exactIndexes[serverName].push_back(index);
+
+	if(serverName.size() < 2 || serverName[0] != '*' || serverName[1] != '.') {
+		return;
+	}
+
+	/* insert labels of "*.<suffix>" in reverse order, e.g. "*.www.example.com" -> "com", "example", "www" */
+	std::vector<std::string> labels;
+	for(std::string::size_type begin = 2;;) {
+		std::string::size_type dot = serverName.find('.', begin);
+		if(dot == std::string::npos) {
+			labels.push_back(serverName.substr(begin));
+			break;
+		}
+		labels.push_back(serverName.substr(begin, dot - begin));
+		begin = dot + 1;
+	}
+
+	Node* node = &wildcardRoot;
+	for(auto labelIter = labels.rbegin(); labelIter != labels.rend(); ++labelIter) {
+		auto iter = node->children.find(*labelIter);
+		if(iter == node->children.end()) {
+			iter = node->children.insert(std::make_pair(*labelIter, std::unique_ptr<Node>(new Node))).first;
+		}
+		node = iter->second.get();
+	}
+
+	node->indexes.push_back(index);
+}
+
+std::size_t HostIndex::find(const std::string& hostName, std::size_t fromIndex) const {
+	std::size_t result = npos;
+
+	findIndex(anyIndexes, fromIndex, result);
+
+	auto exactIter = exactIndexes.find(hostName);
+	if(exactIter != exactIndexes.end()) {
+		findIndex(exactIter->second, fromIndex, result);
+	}
+
+	/* walk labels of the host name from right to left. A wildcard "*.<suffix>" matches if
+	 * there is at least one more label left of <suffix>, i.e. there is a dot in front of it.
+	 */
+	const Node* node = &wildcardRoot;
+	std::string_view name(hostName);
+	for(std::size_t end = name.size(); node && !node->children.empty();) {
+		std::size_t dot = end == 0 ? std::string_view::npos : name.rfind('.', end - 1);
+		if(dot == std::string_view::npos) {
+			/* leftmost label has no dot in front of it, so it cannot be matched by a wildcard */
+			break;
+		}
+
+		auto iter = node->children.find(name.substr(dot + 1, end - dot - 1));
+		if(iter == node->children.end()) {
+			break;
+		}
+		node = iter->second.get();
+		findIndex(node->indexes, fromIndex, result);
+
+		end = dot;
+	}
+
+	return result;
+}
+
+
+} /* namespace http */
+} /* namespace engine */
+} /* namespace openjerry */
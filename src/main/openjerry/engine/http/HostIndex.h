@@ -0,0 +1,73 @@
+/*
+ * This file is part of Jerry application server.
+ * Copyright (C) 2020-2022 Sven Lukas
+ *
+ * Jerry is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as
+ * published by the Free Software Foundation, either version 3 of
+ * the License, or (at your option) any later version.
+ *
+ * Jerry is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public
+ * License along with Jerry.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#ifndef OPENJERRY_ENGINE_HTTP_HOSTINDEX_H_
+#define OPENJERRY_ENGINE_HTTP_HOSTINDEX_H_
+
+#include <cstddef>
+#include <functional>
+#include <map>
+#include <memory>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+namespace openjerry {
+namespace engine {
+namespace http {
+
+
+/* Index of the server names of a consecutive run of host entries of a context.
+ * Exact server names are stored in a hash table, wildcard server names ("*.example.com")
+ * in a trie keyed on the reversed labels and "*" in a separate list. A lookup walks the
+ * labels of the request host name once and does not allocate.
+ */
+class HostIndex {
+public:
+	static constexpr std::size_t npos = static_cast<std::size_t>(-1);
+
+	HostIndex(std::size_t firstIndex);
+
+	std::size_t getFirstIndex() const noexcept;
+	std::size_t getLastIndex() const noexcept;
+
+	void addHost(const std::string& serverName, std::size_t index);
+
+	/* returns the smallest entry index greater or equal to 'fromIndex' of a host matching 'hostName' or npos */
+	std::size_t find(const std::string& hostName, std::size_t fromIndex) const;
+
+private:
+	struct Node {
+		std::map<std::string, std::unique_ptr<Node>, std::less<>> children;
+		std::vector<std::size_t> indexes;
+	};
+
+	std::size_t firstIndex;
+	std::size_t lastIndex;
+
+	std::vector<std::size_t> anyIndexes;
+	std::unordered_map<std::string, std::vector<std::size_t>> exactIndexes;
+	Node wildcardRoot;
+};
+
+
+} /* namespace http */
+} /* namespace engine */
+} /* namespace openjerry */
+
+#endif /* OPENJERRY_ENGINE_HTTP_HOSTINDEX_H_ */
@@ -17,6 +17,7 @@
  */
 
 #include <openjerry/engine/http/InputProxy.h>
+#include <openjerry/engine/http/ObjectPool.h>
 #include <openjerry/engine/http/ExceptionHandler.h>
 #include <openjerry/Logger.h>
 
@@ -36,6 +37,14 @@ esl::io::Input InputProxy::create(esl::io::Input&& input, std::unique_ptr<Reques
 	return esl::io::Input(std::unique_ptr<esl::object::Object>(inputProxy.release()), consumer, writer);
 }
 
+void* InputProxy::operator new(std::size_t size) {
+	return ObjectPool<InputProxy>::allocate(size);
+}
+
+void InputProxy::operator delete(void* ptr, std::size_t size) noexcept {
+	ObjectPool<InputProxy>::deallocate(ptr, size);
+}
+
 InputProxy::InputProxy(esl::io::Input&& aInput, std::unique_ptr<RequestContext> aRequestContext)
 : input(std::move(aInput)),
   isValid(input),
@@ -27,6 +27,7 @@
 #include <esl/io/Writer.h>
 #include <esl/io/Reader.h>
 
+#include <cstddef>
 #include <string>
 #include <memory>
 
@@ -39,6 +40,9 @@ class InputProxy : public esl::object::Object {
 public:
 	static esl::io::Input create(esl::io::Input&& input, std::unique_ptr<RequestContext> requestContext);
 
+	static void* operator new(std::size_t size);
+	static void operator delete(void* ptr, std::size_t size) noexcept;
+
 private:
 	InputProxy(esl::io::Input&& input, std::unique_ptr<RequestContext> requestContext);
 
@@ -0,0 +1,134 @@
+/*
+ * This file is part of Jerry application server.
+ * Copyright (C) 2020-2022 Sven Lukas
+ *
+ * Jerry is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as
+ * published by the Free Software Foundation, either version 3 of
+ * the License, or (at your option) any later version.
+ *
+ * Jerry is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public
+ * License along with Jerry.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include <openjerry/engine/http/Methods.h>
+
+#include <esl/utility/String.h>
+
+#include <stdexcept>
+
+namespace openjerry {
+namespace engine {
+namespace http {
+
+
+namespace {
+struct MethodName {
+	Methods::Mask mask;
+	const char* name;
+};
+
+const MethodName methodNames[] = {
+	{ Methods::get,     "GET" },
+	{ Methods::head,    "HEAD" },
+	{ Methods::post,    "POST" },
+	{ Methods::put,     "PUT" },
+	{ Methods::remove,  "DELETE" },
+	{ Methods::patch,   "PATCH" },
+	{ Methods::options, "OPTIONS" },
+	{ Methods::connect, "CONNECT" },
+	{ Methods::trace,   "TRACE" }
+};
+} /* anonymous namespace */
+
+Methods::Mask Methods::fromString(const std::string& methods) {
+	if(esl::utility::String::trim(methods) == "*") {
+		return all;
+	}
+
+	Mask mask = 0;
+	for(const auto& methodStr : esl::utility::String::split(methods, ',')) {
+		std::string method = esl::utility::String::toUpper(esl::utility::String::trim(methodStr));
+		if(method.empty()) {
+			continue;
+		}
+
+		bool found = false;
+		for(const auto& methodName : methodNames) {
+			if(method == methodName.name) {
+				mask |= methodName.mask;
+				found = true;
+				break;
+			}
+		}
+		if(!found) {
+			throw std::runtime_error("Unknown HTTP method \"" + method + "\"");
+		}
+	}
+
+	if(mask == 0) {
+		throw std::runtime_error("Empty list of HTTP methods");
+	}
+
+	return mask;
+}
+
+std::string Methods::toString(Mask methods) {
+	if(methods == all) {
+		return "*";
+	}
+
+	std::string rv;
+	for(const auto& methodName : methodNames) {
+		if(methods & methodName.mask) {
+			if(!rv.empty()) {
+				rv += ",";
+			}
+			rv += methodName.name;
+		}
+	}
+	return rv;
+}
+
+Methods::Mask Methods::getMask(const esl::utility::HttpMethod& method) noexcept {
+	using Type = esl::utility::HttpMethod::Type;
+
+	if(method == Type::httpGet) {
+		return get;
+	}
+	if(method == Type::httpHead) {
+		return head;
+	}
+	if(method == Type::httpPost) {
+		return post;
+	}
+	if(method == Type::httpPut) {
+		return put;
+	}
+	if(method == Type::httpDelete) {
+		return remove;
+	}
+	if(method == Type::httpPatch) {
+		return patch;
+	}
+	if(method == Type::httpOptions) {
+		return options;
+	}
+	if(method == Type::httpConnect) {
+		return connect;
+	}
+	if(method == Type::httpTrace) {
+		return trace;
+	}
+	return other;
+}
+
+
+} /* namespace http */
+} /* namespace engine */
+} /* namespace openjerry */
@@ -0,0 +1,60 @@
+/*
+ * This file is part of Jerry application server.
+ * Copyright (C) 2020-2022 Sven Lukas
+ *
+ * Jerry is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as
+ * published by the Free Software Foundation, either version 3 of
+ * the License, or (at your option) any later version.
+ *
+ * Jerry is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public
+ * License along with Jerry.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#ifndef OPENJERRY_ENGINE_HTTP_METHODS_H_
+#define OPENJERRY_ENGINE_HTTP_METHODS_H_
+
+#include <esl/utility/HttpMethod.h>
+
+#include <string>
+
+namespace openjerry {
+namespace engine {
+namespace http {
+
+
+/* Set of HTTP methods stored as bitmask. Methods that have no own bit are only contained in 'all'. */
+class Methods {
+public:
+	using Mask = unsigned short;
+
+	static constexpr Mask get     = 1 << 0;
+	static constexpr Mask head    = 1 << 1;
+	static constexpr Mask post    = 1 << 2;
+	static constexpr Mask put     = 1 << 3;
+	static constexpr Mask remove  = 1 << 4;
+	static constexpr Mask patch   = 1 << 5;
+	static constexpr Mask options = 1 << 6;
+	static constexpr Mask connect = 1 << 7;
+	static constexpr Mask trace   = 1 << 8;
+	static constexpr Mask other   = 1 << 9;
+	static constexpr Mask all     = (1 << 10) - 1;
+
+	/* parses a comma separated list like "GET,HEAD" or "*" and throws a runtime_error if it contains an unknown method */
+	static Mask fromString(const std::string& methods);
+	static std::string toString(Mask methods);
+
+	static Mask getMask(const esl::utility::HttpMethod& method) noexcept;
+};
+
+
+} /* namespace http */
+} /* namespace engine */
+} /* namespace openjerry */
+
+#endif /* OPENJERRY_ENGINE_HTTP_METHODS_H_ */
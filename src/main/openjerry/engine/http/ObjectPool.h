@@ -0,0 +1,118 @@
+/*
+ * This file is part of Jerry application server.
+ * Copyright (C) 2020-2022 Sven Lukas
+ *
+ * Jerry is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as
+ * published by the Free Software Foundation, either version 3 of
+ * the License, or (at your option) any later version.
+ *
+ * Jerry is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public
+ * License along with Jerry.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#ifndef OPENJERRY_ENGINE_HTTP_OBJECTPOOL_H_
+#define OPENJERRY_ENGINE_HTTP_OBJECTPOOL_H_
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <new>
+#include <vector>
+
+namespace openjerry {
+namespace engine {
+namespace http {
+
+
+/* Recycles the memory of per request objects of type T. Each thread keeps its own list
+ * of free blocks, so allocation and deallocation do not need any lock. A class uses the
+ * pool by implementing its class specific operator new and operator delete with
+ * allocate() and deallocate().
+ */
+template <class T>
+class ObjectPool {
+public:
+	static constexpr std::size_t maxBlocksPerThread = 256;
+
+	static void* allocate(std::size_t size) {
+		/* objects of derived classes have a different size and are not pooled */
+		if(size != sizeof(T)) {
+			return ::operator new(size);
+		}
+
+		std::vector<void*>& blocks = getBlocks();
+		if(blocks.empty()) {
+			misses.fetch_add(1, std::memory_order_relaxed);
+			return ::operator new(size);
+		}
+
+		hits.fetch_add(1, std::memory_order_relaxed);
+		void* block = blocks.back();
+		blocks.pop_back();
+		return block;
+	}
+
+	static void deallocate(void* block, std::size_t size) noexcept {
+		if(block == nullptr) {
+			return;
+		}
+
+		if(size == sizeof(T)) {
+			std::vector<void*>& blocks = getBlocks();
+			if(blocks.size() < maxBlocksPerThread) {
+				blocks.push_back(block);
+				return;
+			}
+		}
+
+		::operator delete(block);
+	}
+
+	static std::uint64_t getHits() noexcept {
+		return hits.load(std::memory_order_relaxed);
+	}
+
+	static std::uint64_t getMisses() noexcept {
+		return misses.load(std::memory_order_relaxed);
+	}
+
+	/* returns the hit rate in percent */
+	static unsigned int getHitRate() noexcept {
+		std::uint64_t allocations = getHits() + getMisses();
+		return allocations == 0 ? 0 : static_cast<unsigned int>((getHits() * 100) / allocations);
+	}
+
+private:
+	struct Blocks : std::vector<void*> {
+		Blocks() {
+			reserve(maxBlocksPerThread);
+		}
+
+		~Blocks() {
+			for(void* block : *this) {
+				::operator delete(block);
+			}
+		}
+	};
+
+	static std::vector<void*>& getBlocks() {
+		thread_local Blocks blocks;
+		return blocks;
+	}
+
+	static inline std::atomic<std::uint64_t> hits{0};
+	static inline std::atomic<std::uint64_t> misses{0};
+};
+
+
+} /* namespace http */
+} /* namespace engine */
+} /* namespace openjerry */
+
+#endif /* OPENJERRY_ENGINE_HTTP_OBJECTPOOL_H_ */
@@ -17,6 +17,7 @@
  */
 
 #include <openjerry/engine/http/RequestContext.h>
+#include <openjerry/engine/http/ObjectPool.h>
 #include <openjerry/Logger.h>
 
 #include <esl/io/Output.h>
@@ -33,9 +34,17 @@ Logger logger("openjerry::engine::http::RequestContext");
 RequestContext::RequestContext(esl::com::http::server::RequestContext& aRequestContext)
 : baseRequestContext(aRequestContext),
   connection(*this, aRequestContext.getConnection()),
-  path(aRequestContext.getPath())
+  requestPath(aRequestContext.getPath())
 { }
 
+void* RequestContext::operator new(std::size_t size) {
+	return ObjectPool<RequestContext>::allocate(size);
+}
+
+void RequestContext::operator delete(void* ptr, std::size_t size) noexcept {
+	ObjectPool<RequestContext>::deallocate(ptr, size);
+}
+
 esl::com::http::server::Connection& RequestContext::getConnection() const {
 	return const_cast<Connection&>(connection);
 }
@@ -44,14 +53,31 @@ const esl::com::http::server::Request& RequestContext::getRequest() const {
 	return baseRequestContext.getRequest();
 }
 
-void RequestContext::setPath(std::string aPath) {
-	path = std::move(aPath);
-}
-
 const std::string& RequestContext::getPath() const {
+	if(pathOffset == 0) {
+		return requestPath;
+	}
+
+	if(pathMaterializedOffset != pathOffset) {
+		/* assign() reuses the capacity of 'path', so there is at most one allocation per request */
+		path.assign(requestPath, pathOffset, std::string::npos);
+		pathMaterializedOffset = pathOffset;
+	}
 	return path;
 }
 
+void RequestContext::setPathOffset(std::size_t aPathOffset) noexcept {
+	pathOffset = aPathOffset;
+}
+
+std::size_t RequestContext::getPathOffset() const noexcept {
+	return pathOffset;
+}
+
+std::string_view RequestContext::getPathView() const noexcept {
+	return std::string_view(requestPath).substr(pathOffset);
+}
+
 esl::object::Context& RequestContext::getObjectContext() {
 	return baseRequestContext.getObjectContext();
 }
@@ -27,7 +27,9 @@
 #include <esl/com/http/server/Request.h>
 #include <esl/object/Context.h>
 
+#include <cstddef>
 #include <string>
+#include <string_view>
 
 namespace openjerry {
 namespace engine {
@@ -38,10 +40,18 @@ class RequestContext : public esl::com::http::server::RequestContext {
 public:
 	RequestContext(esl::com::http::server::RequestContext& requestContext);
 
+	static void* operator new(std::size_t size);
+	static void operator delete(void* ptr, std::size_t size) noexcept;
+
 	esl::com::http::server::Connection& getConnection() const override;
 	const esl::com::http::server::Request& getRequest() const override;
-	void setPath(std::string path);
 	const std::string& getPath() const override;
+
+	/* local path is the suffix of the request path starting at 'pathOffset' */
+	void setPathOffset(std::size_t pathOffset) noexcept;
+	std::size_t getPathOffset() const noexcept;
+	std::string_view getPathView() const noexcept;
+
 	esl::object::Context& getObjectContext() override;
 	const esl::object::Context& getObjectContext() const override;
 
@@ -54,7 +64,12 @@ public:
 private:
 	esl::com::http::server::RequestContext& baseRequestContext;
 	Connection connection;
-	std::string path;
+	const std::string& requestPath;
+	std::size_t pathOffset = 0;
+
+	/* materialized local path, only used if getPath() is called with a path offset != 0 */
+	mutable std::string path;
+	mutable std::size_t pathMaterializedOffset = 0;
 
 	const Context* headersContext = nullptr;
 	const Context* errorHandlingContext = nullptr;
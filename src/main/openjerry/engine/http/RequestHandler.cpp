@@ -19,6 +19,7 @@
 #include <openjerry/engine/http/RequestHandler.h>
 #include <openjerry/engine/http/RequestContext.h>
 #include <openjerry/engine/http/Context.h>
+#include <openjerry/engine/http/DispatchTrace.h>
 #include <openjerry/engine/http/InputProxy.h>
 #include <openjerry/engine/http/ExceptionHandler.h>
 #include <openjerry/Logger.h>
@@ -41,6 +42,29 @@ RequestHandler::RequestHandler(Context& aContext)
 : context(aContext)
 { }
 
+void RequestHandler::setRouteCache(RouteCache* aRouteCache) {
+	routeCache = aRouteCache;
+}
+
+void RequestHandler::setTraceSampleRate(std::size_t aTraceSampleRate) {
+	traceSampleRate = aTraceSampleRate;
+}
+
+void RequestHandler::setTraceHeader(const std::string& aTraceHeader) {
+	traceHeader = aTraceHeader;
+}
+
+bool RequestHandler::isTracing() const noexcept {
+	return traceSampleRate > 0 || !traceHeader.empty();
+}
+
+bool RequestHandler::isSampled(const esl::com::http::server::RequestContext& requestContext) const {
+	if(traceSampleRate > 0 && traceCounter.fetch_add(1, std::memory_order_relaxed) % traceSampleRate == 0) {
+		return true;
+	}
+	return !traceHeader.empty() && requestContext.getRequest().hasHeader(traceHeader);
+}
+
 esl::io::Input RequestHandler::accept(esl::com::http::server::RequestContext& baseRequestContext) const {
 	std::unique_ptr<RequestContext> requestContext(new RequestContext(baseRequestContext));
 
@@ -48,7 +72,42 @@ esl::io::Input RequestHandler::accept(esl::com::http::server::RequestContext& ba
 		/* Access log */
 		logger.info << "Request for hostname " << baseRequestContext.getRequest().getHostName() << ": " << baseRequestContext.getRequest().getMethod().toString() << " \"" << baseRequestContext.getRequest().getPath() << "\" received from " << baseRequestContext.getRequest().getRemoteAddress() << "\n";
 
-		esl::io::Input input = context.accept(*requestContext);
+		if(isTracing() && isSampled(baseRequestContext)) {
+			std::unique_ptr<DispatchTrace> trace(new DispatchTrace);
+			esl::io::Input input;
+
+			try {
+				input = context.accept(*requestContext, routeCache, trace.get());
+			}
+			catch(...) {
+				trace->finish(false);
+				trace->aggregate();
+				throw;
+			}
+
+			trace->finish(static_cast<bool>(input));
+			trace->aggregate();
+
+			if(logger.trace) {
+				logger.trace << "Dispatch trace of \"" << baseRequestContext.getRequest().getPath() << "\" (" << trace->size() << " entries, " << trace->getDropped() << " dropped):\n";
+				for(std::size_t i = 0; i < trace->size(); ++i) {
+					const DispatchTrace::Record& record = (*trace)[i];
+					for(std::size_t depth = 0; depth < record.depth; ++depth) {
+						logger.trace << "|   ";
+					}
+					logger.trace << record.plan->getDescription(record.instruction) << " -> "
+							<< (record.result == DispatchTrace::Result::accept ? "accept" : record.result == DispatchTrace::Result::match ? "match" : "miss")
+							<< " (" << record.ns << "ns)\n";
+				}
+			}
+
+			if(input) {
+				return InputProxy::create(std::move(input), std::move(requestContext));
+			}
+			throw esl::com::http::server::exception::StatusCode(404);
+		}
+
+		esl::io::Input input = context.accept(*requestContext, routeCache);
 		if(input) {
 			return InputProxy::create(std::move(input), std::move(requestContext));
 		}
@@ -23,12 +23,17 @@
 #include <esl/com/http/server/RequestContext.h>
 #include <esl/io/Input.h>
 
+#include <atomic>
+#include <cstddef>
+#include <string>
+
 namespace openjerry {
 namespace engine {
 namespace http {
 
 
 class Context;
+class RouteCache;
 
 class RequestHandler final : public esl::com::http::server::RequestHandler {
 public:
@@ -36,8 +41,22 @@ public:
 
 	esl::io::Input accept(esl::com::http::server::RequestContext& requestContext) const override;
 
+	void setRouteCache(RouteCache* routeCache);
+
+	/* traces every n-th request and each request that has the trace header, 0 and "" disable tracing */
+	void setTraceSampleRate(std::size_t traceSampleRate);
+	void setTraceHeader(const std::string& traceHeader);
+	bool isTracing() const noexcept;
+
 private:
 	Context& context;
+	RouteCache* routeCache = nullptr;
+
+	std::size_t traceSampleRate = 0;
+	std::string traceHeader;
+	mutable std::atomic<std::size_t> traceCounter{0};
+
+	bool isSampled(const esl::com::http::server::RequestContext& requestContext) const;
 };
 
 
@@ -0,0 +1,55 @@
+/*
+ * This file is part of Jerry application server.
+ * Copyright (C) 2020-2022 Sven Lukas
+ *
+ * Jerry is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as
+ * published by the Free Software Foundation, either version 3 of
+ * the License, or (at your option) any later version.
+ *
+ * Jerry is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public
+ * License along with Jerry.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#ifndef OPENJERRY_ENGINE_HTTP_RESPONSEHEADERS_H_
+#define OPENJERRY_ENGINE_HTTP_RESPONSEHEADERS_H_
+
+#include <esl/com/http/server/Response.h>
+
+#include <map>
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace openjerry {
+namespace engine {
+namespace http {
+
+
+/* Frozen set of response headers of a context. It is built once at initializeContext()
+ * from the effective headers and stored in one contiguous array, so attaching it to a
+ * response does not walk a std::map.
+ */
+class ResponseHeaders {
+public:
+	ResponseHeaders() = default;
+	ResponseHeaders(const std::map<std::string, std::string>& headers);
+
+	bool empty() const noexcept;
+	void addTo(esl::com::http::server::Response& response) const;
+
+private:
+	std::vector<std::pair<std::string, std::string>> headers;
+};
+
+
+} /* namespace http */
+} /* namespace engine */
+} /* namespace openjerry */
+
+#endif /* OPENJERRY_ENGINE_HTTP_RESPONSEHEADERS_H_ */
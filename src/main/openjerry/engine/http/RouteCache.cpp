@@ -0,0 +1,120 @@
+/*
+ * This file is part of Jerry application server.
+ * Copyright (C) 2020-2022 Sven Lukas
+ *
+ * Jerry is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as
+ * published by the Free Software Foundation, either version 3 of
+ * the License, or (at your option) any later version.
+ *
+ * Jerry is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public
+ * License along with Jerry.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include <openjerry/engine/http/RouteCache.h>
+
+#include <algorithm>
+#include <cstdint>
+#include <functional>
+
+namespace openjerry {
+namespace engine {
+namespace http {
+
+
+RouteCache::RouteCache(std::size_t aMaxSize, std::size_t shardCount)
+: maxSize(aMaxSize)
+{
+	shardCount = std::max<std::size_t>(1, std::min(shardCount, maxSize));
+
+	/* the remainder is distributed to the first shards, so all shards together hold 'maxSize' routes */
+	for(std::size_t i = 0; i < shardCount; ++i) {
+		shards.emplace_back(new Shard);
+		shards.back()->maxSize = maxSize / shardCount + (i < maxSize % shardCount ? 1 : 0);
+	}
+}
+
+std::shared_ptr<const RouteCache::Route> RouteCache::find(const std::string& hostName, const std::string& method, std::string_view path) {
+	std::size_t hash = getHash(hostName, method, path);
+	Shard& shard = getShard(hash);
+	std::lock_guard<std::mutex> lock(shard.mutex);
+
+	auto iter = shard.entryByHash.find(hash);
+	if(iter == shard.entryByHash.end() || iter->second->hostName != hostName || iter->second->method != method || iter->second->path != path) {
+		misses.fetch_add(1, std::memory_order_relaxed);
+		return nullptr;
+	}
+
+	hits.fetch_add(1, std::memory_order_relaxed);
+	shard.entries.splice(shard.entries.begin(), shard.entries, iter->second);
+	return iter->second->route;
+}
+
+void RouteCache::insert(const std::string& hostName, const std::string& method, std::string_view path, std::shared_ptr<const Route> route) {
+	if(maxSize == 0 || !route || route->empty()) {
+		return;
+	}
+
+	std::size_t hash = getHash(hostName, method, path);
+	Shard& shard = getShard(hash);
+	std::lock_guard<std::mutex> lock(shard.mutex);
+
+	/* an entry with the same hash is replaced, even if it has a different key */
+	auto iter = shard.entryByHash.find(hash);
+	if(iter != shard.entryByHash.end()) {
+		shard.entries.erase(iter->second);
+		shard.entryByHash.erase(iter);
+	}
+
+	while(!shard.entries.empty() && shard.entries.size() >= shard.maxSize) {
+		shard.entryByHash.erase(shard.entries.back().hash);
+		shard.entries.pop_back();
+	}
+
+	shard.entries.push_front(Entry{hash, hostName, method, std::string(path), std::move(route)});
+	shard.entryByHash[hash] = shard.entries.begin();
+}
+
+void RouteCache::clear() {
+	for(auto& shard : shards) {
+		std::lock_guard<std::mutex> lock(shard->mutex);
+
+		shard->entryByHash.clear();
+		shard->entries.clear();
+	}
+}
+
+std::size_t RouteCache::getMaxSize() const noexcept {
+	return maxSize;
+}
+
+std::uint64_t RouteCache::getHits() const noexcept {
+	return hits.load(std::memory_order_relaxed);
+}
+
+std::uint64_t RouteCache::getMisses() const noexcept {
+	return misses.load(std::memory_order_relaxed);
+}
+
+std::size_t RouteCache::getHash(const std::string& hostName, const std::string& method, std::string_view path) {
+	std::size_t hash = std::hash<std::string_view>()(hostName);
+	hash = hash * 31 + std::hash<std::string_view>()(method);
+	hash = hash * 31 + std::hash<std::string_view>()(path);
+	return hash;
+}
+
+RouteCache::Shard& RouteCache::getShard(std::size_t hash) {
+	/* the lower bits select the bucket of the hash table of a shard, so the shard is selected by mixed upper bits */
+	std::uint64_t value = static_cast<std::uint64_t>(hash) * 0x9e3779b97f4a7c15ULL;
+	return *shards[(value >> 32) % shards.size()];
+}
+
+
+} /* namespace http */
+} /* namespace engine */
+} /* namespace openjerry */
@@ -0,0 +1,101 @@
+/*
+ * This file is part of Jerry application server.
+ * Copyright (C) 2020-2022 Sven Lukas
+ *
+ * Jerry is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as
+ * published by the Free Software Foundation, either version 3 of
+ * the License, or (at your option) any later version.
+ *
+ * Jerry is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public
+ * License along with Jerry.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#ifndef OPENJERRY_ENGINE_HTTP_ROUTECACHE_H_
+#define OPENJERRY_ENGINE_HTTP_ROUTECACHE_H_
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <list>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
+
+namespace openjerry {
+namespace engine {
+namespace http {
+
+
+/* Bounded LRU cache that maps (host, method, path) of a request to the instructions of
+ * the dispatch plan that have been executed until the request has been accepted. The
+ * dispatch plan replays a cached route without doing any host or endpoint lookup.
+ * The cache is divided into shards with their own lock and LRU list, so it is not a
+ * global contention point in front of dispatching.
+ */
+class RouteCache {
+public:
+	struct Step {
+		std::size_t instruction;
+
+		/* number of path characters consumed by an entered endpoint */
+		std::size_t matchSize;
+	};
+	using Route = std::vector<Step>;
+
+	static constexpr std::size_t defaultShardCount = 16;
+
+	/* 'maxSize' is the number of routes of all shards, there are not more shards than routes */
+	RouteCache(std::size_t maxSize, std::size_t shardCount = defaultShardCount);
+
+	std::shared_ptr<const Route> find(const std::string& hostName, const std::string& method, std::string_view path);
+	void insert(const std::string& hostName, const std::string& method, std::string_view path, std::shared_ptr<const Route> route);
+	void clear();
+
+	std::size_t getMaxSize() const noexcept;
+	std::uint64_t getHits() const noexcept;
+	std::uint64_t getMisses() const noexcept;
+
+private:
+	struct Entry {
+		std::size_t hash;
+		std::string hostName;
+		std::string method;
+		std::string path;
+		std::shared_ptr<const Route> route;
+	};
+
+	struct Shard {
+		std::size_t maxSize = 0;
+
+		std::mutex mutex;
+
+		/* most recently used entry is at front */
+		std::list<Entry> entries;
+		std::unordered_map<std::size_t, std::list<Entry>::iterator> entryByHash;
+	};
+
+	const std::size_t maxSize;
+	std::vector<std::unique_ptr<Shard>> shards;
+
+	std::atomic<std::uint64_t> hits{0};
+	std::atomic<std::uint64_t> misses{0};
+
+	static std::size_t getHash(const std::string& hostName, const std::string& method, std::string_view path);
+	Shard& getShard(std::size_t hash);
+};
+
+
+} /* namespace http */
+} /* namespace engine */
+} /* namespace openjerry */
+
+#endif /* OPENJERRY_ENGINE_HTTP_ROUTECACHE_H_ */
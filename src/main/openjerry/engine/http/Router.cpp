@@ -0,0 +1,129 @@
+/*
+ * This file is part of Jerry application server.
+ * Copyright (C) 2020-2022 Sven Lukas
+ *
+ * Jerry is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as
+ * published by the Free Software Foundation, either version 3 of
+ * the License, or (at your option) any later version.
+ *
+ * Jerry is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public
+ * License along with Jerry.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include <openjerry/engine/http/Router.h>
+
+#include <algorithm>
+
+namespace openjerry {
+namespace engine {
+namespace http {
+
+
+Router::Router(std::size_t aFirstIndex)
+: firstIndex(aFirstIndex),
+  lastIndex(aFirstIndex)
+{ }
+
+std::size_t Router::getFirstIndex() const noexcept {
+	return firstIndex;
+}
+
+std::size_t Router::getLastIndex() const noexcept {
+	return lastIndex;
+}
+
+void Router::addEndpoint(const std::string& endpointPath, std::size_t index) {
+	if(index > lastIndex) {
+		lastIndex = index;
+	}
+
+	/* an endpoint with an empty path never matches (see Endpoint::getMatch) */
+	if(endpointPath.empty()) {
+		return;
+	}
+
+	Node* node = &root;
+	std::size_t pos = 0;
+
+	while(pos < endpointPath.size()) {
+		auto iter = node->children.find(endpointPath[pos]);
+
+		if(iter == node->children.end()) {
+			std::unique_ptr<Node> newNode(new Node);
+			newNode->label = endpointPath.substr(pos);
+			Node* newNodePtr = newNode.get();
+			node->children.insert(std::make_pair(endpointPath[pos], std::move(newNode)));
+			node = newNodePtr;
+			pos = endpointPath.size();
+			break;
+		}
+
+		Node& child = *iter->second;
+		std::size_t common = 0;
+		while(common < child.label.size() && pos + common < endpointPath.size() && child.label[common] == endpointPath[pos + common]) {
+			++common;
+		}
+
+		if(common < child.label.size()) {
+			/* split the edge of 'child' at position 'common' */
+			std::unique_ptr<Node> splitNode(new Node);
+			splitNode->label = child.label.substr(0, common);
+			child.label.erase(0, common);
+			char childKey = child.label[0];
+			splitNode->children.insert(std::make_pair(childKey, std::move(iter->second)));
+			iter->second = std::move(splitNode);
+		}
+
+		node = iter->second.get();
+		pos += common;
+	}
+
+	/* entries are added in order of their index, so 'indexes' stays sorted */
+	node->indexes.push_back(index);
+}
+
+std::size_t Router::find(std::string_view requestPath, std::size_t fromIndex) const {
+	/* leading slashes of the request path are ignored (see Endpoint::getMatch) */
+	std::size_t pos = requestPath.find_first_not_of('/');
+	if(pos == std::string_view::npos) {
+		return npos;
+	}
+
+	std::size_t result = npos;
+	const Node* node = &root;
+
+	while(pos < requestPath.size()) {
+		auto iter = node->children.find(requestPath[pos]);
+		if(iter == node->children.end()) {
+			break;
+		}
+
+		const Node& child = *iter->second;
+		if(requestPath.compare(pos, child.label.size(), child.label) != 0) {
+			break;
+		}
+		pos += child.label.size();
+		node = &child;
+
+		/* an endpoint matches only if its path ends at a path separator or at the end of the request path */
+		if(!node->indexes.empty() && (pos == requestPath.size() || requestPath[pos] == '/')) {
+			auto indexIter = std::lower_bound(node->indexes.begin(), node->indexes.end(), fromIndex);
+			if(indexIter != node->indexes.end() && *indexIter < result) {
+				result = *indexIter;
+			}
+		}
+	}
+
+	return result;
+}
+
+
+} /* namespace http */
+} /* namespace engine */
+} /* namespace openjerry */
@@ -0,0 +1,70 @@
+/*
+ * This file is part of Jerry application server.
+ * Copyright (C) 2020-2022 Sven Lukas
+ *
+ * Jerry is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as
+ * published by the Free Software Foundation, either version 3 of
+ * the License, or (at your option) any later version.
+ *
+ * Jerry is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public
+ * License along with Jerry.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#ifndef OPENJERRY_ENGINE_HTTP_ROUTER_H_
+#define OPENJERRY_ENGINE_HTTP_ROUTER_H_
+
+#include <cstddef>
+#include <map>
+#include <memory>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace openjerry {
+namespace engine {
+namespace http {
+
+
+/* Radix tree of the endpoint paths of a consecutive run of endpoint entries of a context.
+ * The tree stores the entry index of each endpoint, so finding the matching endpoints of
+ * a request path depends only on the length of the request path but not on the number of
+ * endpoints.
+ */
+class Router {
+public:
+	static constexpr std::size_t npos = static_cast<std::size_t>(-1);
+
+	Router(std::size_t firstIndex);
+
+	std::size_t getFirstIndex() const noexcept;
+	std::size_t getLastIndex() const noexcept;
+
+	void addEndpoint(const std::string& endpointPath, std::size_t index);
+
+	/* returns the smallest entry index greater or equal to 'fromIndex' of an endpoint matching 'requestPath' or npos */
+	std::size_t find(std::string_view requestPath, std::size_t fromIndex) const;
+
+private:
+	struct Node {
+		std::string label;
+		std::map<char, std::unique_ptr<Node>> children;
+		std::vector<std::size_t> indexes;
+	};
+
+	std::size_t firstIndex;
+	std::size_t lastIndex;
+	Node root;
+};
+
+
+} /* namespace http */
+} /* namespace engine */
+} /* namespace openjerry */
+
+#endif /* OPENJERRY_ENGINE_HTTP_ROUTER_H_ */
@@ -17,6 +17,8 @@
  */
 
 #include <openjerry/engine/http/Server.h>
+#include <openjerry/engine/http/InputProxy.h>
+#include <openjerry/engine/http/ObjectPool.h>
 #include <openjerry/engine/http/RequestContext.h>
 #include <openjerry/engine/ProcessRegistry.h>
 #include <openjerry/Logger.h>
@@ -52,16 +54,49 @@ Server::Server(ProcessRegistry& aProcessRegistry, const std::vector<std::pair<st
 		throw esl::system::Stacktrace::add(std::runtime_error("Could not create an http socket with implementation \"" + implementation + "\""));
 	}
 	context.setProcessRegistry(&processRegistry);
+	context.setDispatchRoot();
 }
 
 void Server::initializeContext() {
 	getContext().initializeContext();
+
+	/* cached routes are referring to instructions of the old dispatch plan */
+	if(routeCache) {
+		routeCache->clear();
+	}
+}
+
+void Server::setRouteCacheSize(std::size_t routeCacheSize) {
+	if(routeCacheSize == 0) {
+		routeCache.reset();
+	}
+	else {
+		routeCache.reset(new RouteCache(routeCacheSize));
+	}
+	requestHandler.setRouteCache(routeCache.get());
+}
+
+void Server::setTraceSampleRate(std::size_t traceSampleRate) {
+	requestHandler.setTraceSampleRate(traceSampleRate);
+}
+
+void Server::setTraceHeader(const std::string& traceHeader) {
+	requestHandler.setTraceHeader(traceHeader);
 }
 
 void Server::procedureRun(esl::object::Context&) {
 	try {
 		processRegistry.processRegister(*this);
 		socket->listen(requestHandler, [this] {
+			logger.info << "Pool hit rate of request contexts: " << ObjectPool<RequestContext>::getHitRate() << "% (" << ObjectPool<RequestContext>::getHits() << " hits, " << ObjectPool<RequestContext>::getMisses() << " misses)\n";
+			logger.info << "Pool hit rate of input proxies: " << ObjectPool<InputProxy>::getHitRate() << "% (" << ObjectPool<InputProxy>::getHits() << " hits, " << ObjectPool<InputProxy>::getMisses() << " misses)\n";
+			if(requestHandler.isTracing()) {
+				logger.info << "Dispatch statistics of sampled requests:\n";
+				context.dumpStatistics();
+			}
+			if(routeCache) {
+				logger.info << "Route cache: " << routeCache->getHits() << " hits, " << routeCache->getMisses() << " misses\n";
+			}
 			processRegistry.processUnregister(*this);
 		});
 	}
@@ -21,6 +21,7 @@
 
 #include <openjerry/engine/http/Context.h>
 #include <openjerry/engine/http/RequestHandler.h>
+#include <openjerry/engine/http/RouteCache.h>
 #include <openjerry/engine/ProcessRegistry.h>
 
 #include <esl/com/http/server/Socket.h>
@@ -43,6 +44,13 @@ public:
 
 	void initializeContext();
 
+	/* a size of 0 disables the route cache */
+	void setRouteCacheSize(std::size_t routeCacheSize);
+
+	/* see RequestHandler::setTraceSampleRate */
+	void setTraceSampleRate(std::size_t traceSampleRate);
+	void setTraceHeader(const std::string& traceHeader);
+
 	void procedureRun(esl::object::Context&) override;
 	void procedureCancel() override;
 
@@ -54,6 +62,7 @@ private:
 	ProcessRegistry& processRegistry;
 	Context context;
 	RequestHandler requestHandler;
+	std::unique_ptr<RouteCache> routeCache;
 
 	const std::string implementation;
 	const std::vector<std::pair<std::string, std::string>> settings;
@@ -0,0 +1,128 @@
+/*
+ * This file is part of Jerry application server.
+ * Copyright (C) 2020-2022 Sven Lukas
+ *
+ * Jerry is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as
+ * published by the Free Software Foundation, either version 3 of
+ * the License, or (at your option) any later version.
+ *
+ * Jerry is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public
+ * License along with Jerry.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include <openjerry/utility/CachePolicy.h>
+#include <openjerry/utility/HttpDate.h>
+
+#include <esl/utility/String.h>
+
+#include <stdexcept>
+
+#include <fnmatch.h>
+
+namespace openjerry {
+namespace utility {
+
+CachePolicy::Rule::Rule(const std::string& rule) {
+	std::string trimmedRule = esl::utility::String::trim(rule);
+	std::string::size_type pos = trimmedRule.find_first_of(" \t");
+	if(pos == std::string::npos) {
+		throw std::runtime_error("Invalid cache-control rule \"" + rule + "\". Rule must be \"<selector> <directives>\"");
+	}
+
+	pattern = trimmedRule.substr(0, pos);
+	cacheControl = esl::utility::String::trim(esl::utility::String::trim(trimmedRule.substr(pos), '\t'));
+
+	if(pattern.rfind("mime:", 0) == 0) {
+		selector = Selector::mime;
+		pattern = esl::utility::String::toLower(pattern.substr(5));
+	}
+	else if(pattern.find('/') != std::string::npos) {
+		selector = Selector::path;
+		/* a relative pattern matches the end of the path */
+		if(pattern.front() != '/' && pattern.front() != '*') {
+			pattern = "*/" + pattern;
+		}
+	}
+	else {
+		selector = Selector::fileName;
+	}
+
+	for(const auto& directive : esl::utility::String::split(cacheControl, ',')) {
+		std::string value = esl::utility::String::toLower(esl::utility::String::trim(directive));
+		if(value.rfind("max-age=", 0) == 0) {
+			try {
+				maxAge = std::chrono::seconds(std::stol(value.substr(8)));
+				hasMaxAge = true;
+			}
+			catch(...) {
+				throw std::runtime_error("Invalid max-age in cache-control rule \"" + rule + "\"");
+			}
+		}
+	}
+}
+
+bool CachePolicy::Rule::isMatch(const std::string& path, const std::string& fileName, const std::string& mimeType) const {
+	switch(selector) {
+	case Selector::fileName:
+		return fnmatch(pattern.c_str(), fileName.c_str(), 0) == 0;
+	case Selector::path:
+		return fnmatch(pattern.c_str(), path.c_str(), 0) == 0;
+	case Selector::mime:
+		return fnmatch(pattern.c_str(), mimeType.c_str(), 0) == 0;
+	}
+	return false;
+}
+
+void CachePolicy::Rule::addHeaders(esl::com::http::server::Response& response) const {
+	response.addHeader("Cache-Control", cacheControl);
+	if(hasMaxAge) {
+		response.addHeader("Expires", HttpDate::toString(std::chrono::system_clock::now() + maxAge));
+	}
+}
+
+void CachePolicy::addRule(const std::string& rule) {
+	rules.emplace_back(rule);
+	if(esl::utility::String::trim(rule).rfind("mime:", 0) == 0) {
+		hasMimeRules = true;
+	}
+}
+
+const CachePolicy::Rule* CachePolicy::find(const std::string& path, const esl::utility::MIME& mime) const {
+	if(rules.empty()) {
+		return nullptr;
+	}
+
+	std::string::size_type pos = path.find_last_of('/');
+	std::string fileName = (pos == std::string::npos) ? path : path.substr(pos + 1);
+
+	/* the MIME type is only converted to a string if it is needed */
+	std::string mimeType;
+	if(hasMimeRules) {
+		mimeType = esl::utility::String::toLower(mime.toString());
+		pos = mimeType.find(';');
+		if(pos != std::string::npos) {
+			mimeType = esl::utility::String::trim(mimeType.substr(0, pos));
+		}
+	}
+
+	for(const auto& rule : rules) {
+		if(rule.isMatch(path, fileName, mimeType)) {
+			return &rule;
+		}
+	}
+
+	return nullptr;
+}
+
+bool CachePolicy::empty() const noexcept {
+	return rules.empty();
+}
+
+} /* namespace utility */
+} /* namespace openjerry */
@@ -0,0 +1,80 @@
+/*
+ * This file is part of Jerry application server.
+ * Copyright (C) 2020-2022 Sven Lukas
+ *
+ * Jerry is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as
+ * published by the Free Software Foundation, either version 3 of
+ * the License, or (at your option) any later version.
+ *
+ * Jerry is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public
+ * License along with Jerry.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#ifndef OPENJERRY_UTILITY_CACHEPOLICY_H_
+#define OPENJERRY_UTILITY_CACHEPOLICY_H_
+
+#include <esl/com/http/server/Response.h>
+#include <esl/utility/MIME.h>
+
+#include <chrono>
+#include <string>
+#include <vector>
+
+namespace openjerry {
+namespace utility {
+
+/* Ordered rules for the Cache-Control header of static responses. A rule has the form
+ * "<selector> <directives>", e.g. "*.html no-cache" or "mime:image/png public, max-age=86400, immutable".
+ * The selector is a glob pattern matching the file name, or a glob pattern matching the path relative
+ * to the handler's 'path' if the pattern contains a '/', or a glob pattern of the MIME type with prefix
+ * "mime:". A path pattern starting with '/' is anchored at the handler's 'path', e.g. "/assets/app-*.js" matches
+ * "/assets/app-1f3a.js", other path patterns match the end of the path. The first matching rule is used.
+ * If its directives contain max-age, an Expires header is sent as well.
+ */
+class CachePolicy {
+public:
+	class Rule {
+	public:
+		Rule(const std::string& rule);
+
+		bool isMatch(const std::string& path, const std::string& fileName, const std::string& mimeType) const;
+		void addHeaders(esl::com::http::server::Response& response) const;
+
+	private:
+		enum class Selector {
+			fileName,
+			path,
+			mime
+		};
+
+		Selector selector;
+		std::string pattern;
+
+		/* header value as configured, so it is not built per request */
+		std::string cacheControl;
+		bool hasMaxAge = false;
+		std::chrono::seconds maxAge;
+	};
+
+	void addRule(const std::string& rule);
+
+	/* returns the first rule matching file 'path' with type 'mime' or nullptr, 'path' is relative to the handler's 'path' and starts with '/' */
+	const Rule* find(const std::string& path, const esl::utility::MIME& mime) const;
+
+	bool empty() const noexcept;
+
+private:
+	std::vector<Rule> rules;
+	bool hasMimeRules = false;
+};
+
+} /* namespace utility */
+} /* namespace openjerry */
+
+#endif /* OPENJERRY_UTILITY_CACHEPOLICY_H_ */
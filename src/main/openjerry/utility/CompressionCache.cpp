@@ -0,0 +1,256 @@
+/*
+ * This file is part of Jerry application server.
+ * Copyright (C) 2020-2022 Sven Lukas
+ *
+ * Jerry is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as
+ * published by the Free Software Foundation, either version 3 of
+ * the License, or (at your option) any later version.
+ *
+ * Jerry is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public
+ * License along with Jerry.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include <openjerry/utility/CompressionCache.h>
+#include <openjerry/Logger.h>
+
+#include <exception>
+#include <fstream>
+#include <iterator>
+
+#include <zlib.h>
+#ifdef OPENJERRY_USE_ZSTD
+#include <zstd.h>
+#endif
+
+namespace openjerry {
+namespace utility {
+
+namespace {
+Logger logger("openjerry::utility::CompressionCache");
+
+/* estimated memory usage of a node without the compressed content */
+constexpr std::size_t nodeOverhead = 256;
+
+constexpr int gzipLevel = 6;
+#ifdef OPENJERRY_USE_ZSTD
+constexpr int zstdLevel = 3;
+#endif
+
+bool compressGzip(const std::string& input, std::string& output) {
+	z_stream stream{};
+	/* window bits 15 + 16 writes a gzip header instead of a zlib header */
+	if(deflateInit2(&stream, gzipLevel, Z_DEFLATED, 15 + 16, 8, Z_DEFAULT_STRATEGY) != Z_OK) {
+		return false;
+	}
+
+	output.resize(deflateBound(&stream, static_cast<uLong>(input.size())));
+	stream.next_in = reinterpret_cast<Bytef*>(const_cast<char*>(input.data()));
+	stream.avail_in = static_cast<uInt>(input.size());
+	stream.next_out = reinterpret_cast<Bytef*>(&output[0]);
+	stream.avail_out = static_cast<uInt>(output.size());
+
+	int rc = deflate(&stream, Z_FINISH);
+	output.resize(stream.total_out);
+	deflateEnd(&stream);
+
+	return rc == Z_STREAM_END;
+}
+
+#ifdef OPENJERRY_USE_ZSTD
+bool compressZstd(const std::string& input, std::string& output) {
+	output.resize(ZSTD_compressBound(input.size()));
+	std::size_t rc = ZSTD_compress(&output[0], output.size(), input.data(), input.size(), zstdLevel);
+	if(ZSTD_isError(rc)) {
+		return false;
+	}
+	output.resize(rc);
+	return true;
+}
+#endif
+
+std::string getVersion(const FileCache::Entry& entry) {
+	return std::to_string(entry.size) + ":" + std::to_string(entry.inode) + ":"
+			+ std::to_string(std::chrono::duration_cast<std::chrono::nanoseconds>(entry.lastModified.time_since_epoch()).count());
+}
+} /* anonymous namespace */
+
+CompressionCache::CompressionCache(std::size_t aMaxBytes, std::size_t aMaxFileSize)
+: maxBytes(aMaxBytes),
+  maxFileSize(aMaxFileSize)
+{ }
+
+std::shared_ptr<const FileCache::Entry> CompressionCache::get(const std::string& path, const FileCache::Entry& entry, Encoding encoding) {
+	if(entry.type != FileCache::Type::regularFile || entry.size > maxFileSize || !isSupported(encoding)) {
+		return nullptr;
+	}
+
+	std::string key = std::string(toString(encoding)) + "\n" + path;
+	std::string version = getVersion(entry);
+	std::string versionKey = key + "\n" + version;
+
+	std::promise<std::shared_ptr<const FileCache::Entry>> promise;
+	{
+		std::unique_lock<std::mutex> lock(mutex);
+
+		auto iter = nodeByKey.find(key);
+		if(iter != nodeByKey.end() && iter->second->version == version) {
+			nodes.splice(nodes.begin(), nodes, iter->second);
+			hits.fetch_add(1, std::memory_order_relaxed);
+			return iter->second->variant;
+		}
+
+		auto pendingIter = pendingByVersionKey.find(versionKey);
+		if(pendingIter != pendingByVersionKey.end()) {
+			std::shared_future<std::shared_ptr<const FileCache::Entry>> pending = pendingIter->second;
+			lock.unlock();
+			coalesced.fetch_add(1, std::memory_order_relaxed);
+			return pending.get();
+		}
+
+		pendingByVersionKey[versionKey] = promise.get_future().share();
+	}
+
+	misses.fetch_add(1, std::memory_order_relaxed);
+
+	std::shared_ptr<const FileCache::Entry> variant;
+	try {
+		variant = compress(path, entry, encoding);
+	}
+	catch(...) {
+		logger.warn << "Compression of file \"" << path << "\" failed.\n";
+	}
+
+	/* the pending compression must be removed and waiting requests must be woken up on any exception,
+	 * otherwise all later requests of this version would wait for a promise that is never satisfied */
+	try {
+		/* a result of nullptr is cached as well, so incompressible files are not compressed again */
+		Node node;
+		node.key = key;
+		node.version = version;
+		node.bytes = nodeOverhead + key.size() + version.size() + (variant ? variant->content->size() : 0);
+		node.variant = variant;
+
+		std::lock_guard<std::mutex> lock(mutex);
+
+		pendingByVersionKey.erase(versionKey);
+
+		auto iter = nodeByKey.find(key);
+		if(iter != nodeByKey.end()) {
+			erase(iter->second);
+		}
+
+		if(node.bytes <= maxBytes) {
+			while(!nodes.empty() && bytes + node.bytes > maxBytes) {
+				erase(std::prev(nodes.end()));
+			}
+
+			bytes += node.bytes;
+			nodes.push_front(std::move(node));
+			nodeByKey[key] = nodes.begin();
+		}
+	}
+	catch(...) {
+		{
+			std::lock_guard<std::mutex> lock(mutex);
+			pendingByVersionKey.erase(versionKey);
+		}
+		promise.set_exception(std::current_exception());
+		throw;
+	}
+
+	promise.set_value(variant);
+	return variant;
+}
+
+bool CompressionCache::isSupported(Encoding encoding) noexcept {
+	switch(encoding) {
+	case Encoding::gzip:
+		return true;
+	case Encoding::zstd:
+#ifdef OPENJERRY_USE_ZSTD
+		return true;
+#else
+		return false;
+#endif
+	}
+	return false;
+}
+
+const char* CompressionCache::toString(Encoding encoding) noexcept {
+	switch(encoding) {
+	case Encoding::gzip:
+		return "gzip";
+	case Encoding::zstd:
+		return "zstd";
+	}
+	return "";
+}
+
+std::uint64_t CompressionCache::getHits() const noexcept {
+	return hits.load(std::memory_order_relaxed);
+}
+
+std::uint64_t CompressionCache::getMisses() const noexcept {
+	return misses.load(std::memory_order_relaxed);
+}
+
+std::uint64_t CompressionCache::getCoalesced() const noexcept {
+	return coalesced.load(std::memory_order_relaxed);
+}
+
+void CompressionCache::erase(std::list<Node>::iterator nodeIter) {
+	bytes -= nodeIter->bytes;
+	nodeByKey.erase(nodeIter->key);
+	nodes.erase(nodeIter);
+}
+
+std::shared_ptr<const FileCache::Entry> CompressionCache::compress(const std::string& path, const FileCache::Entry& entry, Encoding encoding) const {
+	std::shared_ptr<const std::string> content = entry.content;
+	if(!content) {
+		std::ifstream file(path, std::ios::binary);
+		std::string fileContent((std::istreambuf_iterator<char>(file)), std::istreambuf_iterator<char>());
+
+		/* the file has been changed while reading */
+		if(!(file.good() || file.eof()) || fileContent.size() != entry.size) {
+			return nullptr;
+		}
+		content = std::make_shared<const std::string>(std::move(fileContent));
+	}
+
+	std::string compressedContent;
+	bool success = false;
+	switch(encoding) {
+	case Encoding::gzip:
+		success = compressGzip(*content, compressedContent);
+		break;
+	case Encoding::zstd:
+#ifdef OPENJERRY_USE_ZSTD
+		success = compressZstd(*content, compressedContent);
+#endif
+		break;
+	}
+
+	if(!success || compressedContent.size() >= content->size()) {
+		return nullptr;
+	}
+
+	std::shared_ptr<FileCache::Entry> variant(new FileCache::Entry(entry));
+	variant->size = compressedContent.size();
+	variant->content = std::make_shared<const std::string>(std::move(compressedContent));
+
+	/* the variant needs its own strong validator, derived from the validator of the file */
+	if(variant->etag.size() >= 2 && variant->etag.back() == '"') {
+		variant->etag = variant->etag.substr(0, variant->etag.size() - 1) + "-" + toString(encoding) + "\"";
+	}
+
+	return variant;
+}
+
+} /* namespace utility */
+} /* namespace openjerry */
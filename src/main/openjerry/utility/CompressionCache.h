@@ -0,0 +1,96 @@
+/*
+ * This file is part of Jerry application server.
+ * Copyright (C) 2020-2022 Sven Lukas
+ *
+ * Jerry is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as
+ * published by the Free Software Foundation, either version 3 of
+ * the License, or (at your option) any later version.
+ *
+ * Jerry is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public
+ * License along with Jerry.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#ifndef OPENJERRY_UTILITY_COMPRESSIONCACHE_H_
+#define OPENJERRY_UTILITY_COMPRESSIONCACHE_H_
+
+#include <openjerry/utility/FileCache.h>
+
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <future>
+#include <list>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+
+namespace openjerry {
+namespace utility {
+
+/* In-memory cache of compressed variants of regular files with a byte budget and LRU eviction.
+ * A variant is valid as long as size, inode and modification time of the file are unchanged.
+ * Concurrent requests of a variant that is not cached yet share a single compression.
+ */
+class CompressionCache {
+public:
+	enum class Encoding {
+		gzip,
+		zstd
+	};
+
+	/* 'maxBytes' is the budget of all variants, 'maxFileSize' the maximum size of a file to compress */
+	CompressionCache(std::size_t maxBytes, std::size_t maxFileSize);
+
+	/* Returns the compressed variant of the regular file 'path' with metadata 'entry' as entry with content.
+	 * Returns nullptr if the file is too large, cannot be read or does not get smaller by compression.
+	 */
+	std::shared_ptr<const FileCache::Entry> get(const std::string& path, const FileCache::Entry& entry, Encoding encoding);
+
+	static bool isSupported(Encoding encoding) noexcept;
+	static const char* toString(Encoding encoding) noexcept;
+
+	std::uint64_t getHits() const noexcept;
+	std::uint64_t getMisses() const noexcept;
+	std::uint64_t getCoalesced() const noexcept;
+
+private:
+	struct Node {
+		std::string key;
+		std::string version;
+		std::size_t bytes;
+		std::shared_ptr<const FileCache::Entry> variant;
+	};
+
+	const std::size_t maxBytes;
+	const std::size_t maxFileSize;
+
+	std::mutex mutex;
+
+	/* most recently used node is at front */
+	std::list<Node> nodes;
+	std::unordered_map<std::string, std::list<Node>::iterator> nodeByKey;
+	std::size_t bytes = 0;
+
+	/* compressions in progress by key and version */
+	std::unordered_map<std::string, std::shared_future<std::shared_ptr<const FileCache::Entry>>> pendingByVersionKey;
+
+	std::atomic<std::uint64_t> hits{0};
+	std::atomic<std::uint64_t> misses{0};
+	std::atomic<std::uint64_t> coalesced{0};
+
+	void erase(std::list<Node>::iterator nodeIter);
+	std::shared_ptr<const FileCache::Entry> compress(const std::string& path, const FileCache::Entry& entry, Encoding encoding) const;
+};
+
+} /* namespace utility */
+} /* namespace openjerry */
+
+#endif /* OPENJERRY_UTILITY_COMPRESSIONCACHE_H_ */
@@ -0,0 +1,50 @@
+/*
+ * This file is part of Jerry application server.
+ * Copyright (C) 2020-2022 Sven Lukas
+ *
+ * Jerry is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as
+ * published by the Free Software Foundation, either version 3 of
+ * the License, or (at your option) any later version.
+ *
+ * Jerry is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public
+ * License along with Jerry.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include <openjerry/utility/ContentProducer.h>
+
+#include <algorithm>
+
+namespace openjerry {
+namespace utility {
+
+ContentProducer::ContentProducer(std::shared_ptr<const std::string> aContent, std::size_t offset, std::size_t size)
+: content(std::move(aContent)),
+  pos(std::min(offset, content->size())),
+  end(pos + std::min(size, content->size() - pos))
+{ }
+
+esl::io::Output ContentProducer::create(std::shared_ptr<const std::string> content, std::size_t offset, std::size_t size) {
+	return esl::io::Output(std::unique_ptr<esl::io::Producer>(new ContentProducer(std::move(content), offset, size)));
+}
+
+std::size_t ContentProducer::produce(esl::io::Writer& writer) {
+	if(pos >= end) {
+		return esl::io::Writer::npos;
+	}
+
+	std::size_t count = writer.write(content->data() + pos, end - pos);
+	if(count != esl::io::Writer::npos) {
+		pos += count;
+	}
+
+	return count;
+}
+
+} /* namespace utility */
+} /* namespace openjerry */
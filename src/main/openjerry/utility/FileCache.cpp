@@ -0,0 +1,522 @@
+/*
+ * This file is part of Jerry application server.
+ * Copyright (C) 2020-2022 Sven Lukas
+ *
+ * Jerry is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as
+ * published by the Free Software Foundation, either version 3 of
+ * the License, or (at your option) any later version.
+ *
+ * Jerry is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public
+ * License along with Jerry.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include <openjerry/utility/FileCache.h>
+#include <openjerry/utility/HttpDate.h>
+#include <openjerry/Logger.h>
+
+#include <cerrno>
+#include <cstdio>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <iterator>
+#include <vector>
+
+#include <poll.h>
+#include <sys/inotify.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+namespace openjerry {
+namespace utility {
+
+namespace {
+Logger logger("openjerry::utility::FileCache");
+
+/* approximated memory of a cache node without path strings and content */
+constexpr std::size_t nodeOverhead = 256;
+
+constexpr uint32_t watchMask = IN_ATTRIB | IN_CLOSE_WRITE | IN_CREATE | IN_DELETE | IN_DELETE_SELF | IN_MODIFY | IN_MOVE_SELF | IN_MOVED_FROM | IN_MOVED_TO;
+
+std::string normalize(const std::string& path) {
+	std::string normalizedPath = std::filesystem::path(path).lexically_normal().generic_string();
+	while(normalizedPath.size() > 1 && normalizedPath.back() == '/') {
+		normalizedPath.pop_back();
+	}
+	return normalizedPath;
+}
+
+std::string toHex(std::uint64_t value) {
+	char buffer[17];
+	std::snprintf(buffer, sizeof(buffer), "%llx", static_cast<unsigned long long>(value));
+	return buffer;
+}
+
+/* FNV-1a, it is not used for security but to detect changed contents */
+std::uint64_t hash(std::uint64_t value, const char* data, std::size_t size) {
+	for(std::size_t i = 0; i < size; ++i) {
+		value ^= static_cast<unsigned char>(data[i]);
+		value *= 0x100000001b3ULL;
+	}
+	return value;
+}
+
+bool hashFile(const std::string& path, std::uint64_t& value) {
+	std::ifstream file(path, std::ios::binary);
+	char buffer[64 * 1024];
+
+	value = 0xcbf29ce484222325ULL;
+	while(file) {
+		file.read(buffer, sizeof(buffer));
+		value = hash(value, buffer, static_cast<std::size_t>(file.gcount()));
+	}
+	return file.eof();
+}
+
+std::string getWatchDirectory(const std::string& path, FileCache::Type type) {
+	if(type == FileCache::Type::directory) {
+		return path;
+	}
+	return std::filesystem::path(path).parent_path().generic_string();
+}
+
+/* returns the components of 'path' that are symbolic links */
+std::vector<std::string> getLinks(const std::string& path) {
+	std::vector<std::string> links;
+	std::filesystem::path currentPath;
+
+	for(const auto& component : std::filesystem::path(path)) {
+		currentPath /= component;
+
+		struct stat linkStat;
+		if(::lstat(currentPath.c_str(), &linkStat) == 0 && S_ISLNK(linkStat.st_mode)) {
+			links.push_back(currentPath.generic_string());
+		}
+	}
+
+	return links;
+}
+} /* anonymous namespace */
+
+FileCache::FileCache(std::size_t aMaxBytes, std::size_t aMaxContentSize, bool aContentHash, std::size_t aMaxMissingEntries)
+: maxBytes(aMaxBytes),
+  maxContentSize(aMaxContentSize),
+  contentHash(aContentHash),
+  maxMissingEntries(aMaxMissingEntries)
+{
+	inotifyFd = inotify_init1(IN_NONBLOCK | IN_CLOEXEC);
+	if(inotifyFd < 0) {
+		logger.warn << "Could not initialize inotify (" << std::strerror(errno) << "), file cache is disabled.\n";
+		return;
+	}
+
+	inotifyThread = std::thread(&FileCache::runInotify, this);
+}
+
+FileCache::~FileCache() {
+	stopped = true;
+	if(inotifyThread.joinable()) {
+		inotifyThread.join();
+	}
+	if(inotifyFd >= 0) {
+		close(inotifyFd);
+	}
+}
+
+std::shared_ptr<const FileCache::Entry> FileCache::get(const std::string& requestedPath) {
+	std::string path = normalize(requestedPath);
+	std::uint64_t loadGeneration;
+	{
+		std::lock_guard<std::mutex> lock(mutex);
+
+		auto iter = nodeByPath.find(path);
+		if(iter != nodeByPath.end()) {
+			std::list<Node>& nodeList = iter->second->missing ? missingNodes : nodes;
+			nodeList.splice(nodeList.begin(), nodeList, iter->second);
+			hits.fetch_add(1, std::memory_order_relaxed);
+			return iter->second->entry;
+		}
+		loadGeneration = generation;
+	}
+
+	misses.fetch_add(1, std::memory_order_relaxed);
+
+	if(inotifyFd < 0) {
+		return load(path, maxContentSize, contentHash);
+	}
+
+	/* Watch parent directory before loading, so a change while loading is seen as invalidation.
+	 * If the parent directory does not exist, the nearest existing ancestor is watched instead,
+	 * so paths below missing directories can be cached as missing entries as well.
+	 */
+	std::string parentDirectory = std::filesystem::path(path).parent_path().generic_string();
+	std::string watchedDirectory = parentDirectory;
+	{
+		std::lock_guard<std::mutex> lock(mutex);
+		while(!addWatch(watchedDirectory)) {
+			std::string ancestor = std::filesystem::path(watchedDirectory).parent_path().generic_string();
+			if(maxMissingEntries == 0 || ancestor.empty() || ancestor == watchedDirectory) {
+				watchedDirectory.clear();
+				break;
+			}
+			watchedDirectory = ancestor;
+		}
+	}
+	if(watchedDirectory.empty()) {
+		return load(path, maxContentSize, contentHash);
+	}
+
+	std::shared_ptr<const Entry> entry = load(path, maxContentSize, contentHash);
+
+	Node node;
+	node.path = path;
+	node.missing = (entry->type == Type::notFound);
+	node.directory = node.missing ? watchedDirectory : getWatchDirectory(path, entry->type);
+	node.bytes = node.missing ? 0 : nodeOverhead + 2 * path.size() + (entry->content ? entry->content->size() : 0);
+	node.entry = entry;
+
+	/* the parent directory has been created while loading */
+	bool isCacheable = node.missing ? maxMissingEntries > 0 : (watchedDirectory == parentDirectory && node.bytes <= maxBytes);
+
+	std::lock_guard<std::mutex> lock(mutex);
+
+	if(!isCacheable || generation != loadGeneration || (node.directory != watchedDirectory && !addWatch(node.directory))) {
+		removeWatchIfUnused(watchedDirectory);
+		return entry;
+	}
+
+	auto iter = nodeByPath.find(path);
+	if(iter != nodeByPath.end()) {
+		erase(iter->second);
+	}
+
+	if(node.missing) {
+		while(!missingNodes.empty() && missingNodes.size() >= maxMissingEntries) {
+			erase(std::prev(missingNodes.end()));
+		}
+	}
+	else {
+		while(!nodes.empty() && bytes + node.bytes > maxBytes) {
+			erase(std::prev(nodes.end()));
+		}
+	}
+
+	std::string directory = node.directory;
+	std::list<Node>& nodeList = node.missing ? missingNodes : nodes;
+	bytes += node.bytes;
+	nodeList.push_front(std::move(node));
+	nodeByPath[path] = nodeList.begin();
+	watchByDirectory[directory].paths.insert(path);
+
+	removeWatchIfUnused(watchedDirectory);
+
+	return entry;
+}
+
+void FileCache::clear() {
+	std::lock_guard<std::mutex> lock(mutex);
+	invalidateAll();
+}
+
+std::shared_ptr<const FileCache::Entry> FileCache::load(const std::string& path, std::size_t maxContentSize, bool contentHash) {
+	std::shared_ptr<Entry> entry(new Entry);
+
+	struct stat fileStat;
+	if(::stat(path.c_str(), &fileStat) != 0) {
+		return entry;
+	}
+
+	if(S_ISDIR(fileStat.st_mode)) {
+		entry->type = Type::directory;
+	}
+	else if(S_ISREG(fileStat.st_mode)) {
+		entry->type = Type::regularFile;
+	}
+	else {
+		entry->type = Type::other;
+	}
+
+	entry->size = static_cast<std::uint64_t>(fileStat.st_size);
+	entry->device = static_cast<std::uint64_t>(fileStat.st_dev);
+	entry->inode = static_cast<std::uint64_t>(fileStat.st_ino);
+	entry->lastModified = std::chrono::system_clock::time_point(std::chrono::duration_cast<std::chrono::system_clock::duration>(
+			std::chrono::seconds(fileStat.st_mtim.tv_sec) + std::chrono::nanoseconds(fileStat.st_mtim.tv_nsec)));
+
+	if(entry->type == Type::regularFile && entry->size <= maxContentSize) {
+		std::ifstream file(path, std::ios::binary);
+		std::string content((std::istreambuf_iterator<char>(file)), std::istreambuf_iterator<char>());
+
+		/* the file has been changed while reading, so do not use the content */
+		if(file.good() || file.eof()) {
+			if(content.size() == entry->size) {
+				entry->content = std::make_shared<const std::string>(std::move(content));
+			}
+		}
+	}
+
+	if(entry->type == Type::regularFile) {
+		std::uint64_t contentValue = 0xcbf29ce484222325ULL;
+
+		if(contentHash && entry->content) {
+			contentValue = hash(contentValue, entry->content->data(), entry->content->size());
+			entry->etag = "\"" + toHex(contentValue) + "-" + toHex(entry->size) + "\"";
+		}
+		else if(contentHash && hashFile(path, contentValue)) {
+			entry->etag = "\"" + toHex(contentValue) + "-" + toHex(entry->size) + "\"";
+		}
+		else {
+			std::uint64_t mtime = static_cast<std::uint64_t>(fileStat.st_mtim.tv_sec) * 1000000000ULL + static_cast<std::uint64_t>(fileStat.st_mtim.tv_nsec);
+			entry->etag = "\"" + toHex(entry->inode) + "-" + toHex(entry->size) + "-" + toHex(mtime) + "\"";
+		}
+		entry->httpLastModified = HttpDate::toString(entry->lastModified);
+	}
+
+	return entry;
+}
+
+std::uint64_t FileCache::getHits() const noexcept {
+	return hits.load(std::memory_order_relaxed);
+}
+
+std::uint64_t FileCache::getMisses() const noexcept {
+	return misses.load(std::memory_order_relaxed);
+}
+
+bool FileCache::addWatch(const std::string& directory) {
+	if(watchByDirectory.find(directory) != watchByDirectory.end()) {
+		return true;
+	}
+
+	int wd = inotify_add_watch(inotifyFd, directory.c_str(), watchMask);
+	if(wd < 0) {
+		logger.debug << "Could not watch directory \"" << directory << "\" (" << std::strerror(errno) << ").\n";
+		return false;
+	}
+
+	/* inotify returns the same watch descriptor if the same directory has been added by another path */
+	auto iter = directoryByWd.find(wd);
+	if(iter != directoryByWd.end() && iter->second != directory) {
+		std::string otherDirectory = iter->second;
+		invalidateTree(otherDirectory);
+
+		auto otherWatchIter = watchByDirectory.find(otherDirectory);
+		if(otherWatchIter != watchByDirectory.end()) {
+			removeWatch(otherWatchIter, false);
+		}
+	}
+
+	watchByDirectory[directory].wd = wd;
+	directoryByWd[wd] = directory;
+
+	/* a symbolic link in the path can be replaced without any event in 'directory', e.g. to switch to a new release */
+	for(const auto& link : getLinks(directory)) {
+		std::string linkDirectory = std::filesystem::path(link).parent_path().generic_string();
+		if(linkDirectory.empty() || linkDirectory == directory || !addWatch(linkDirectory)) {
+			continue;
+		}
+		++watchByDirectory[linkDirectory].linkDependents;
+		watchByDirectory[directory].linkDirectories.push_back(linkDirectory);
+	}
+
+	return true;
+}
+
+void FileCache::removeWatchIfUnused(const std::string& directory) {
+	auto iter = watchByDirectory.find(directory);
+	if(iter == watchByDirectory.end() || !iter->second.paths.empty() || iter->second.linkDependents > 0) {
+		return;
+	}
+
+	removeWatch(iter, true);
+}
+
+void FileCache::removeWatch(std::unordered_map<std::string, Watch>::iterator watchIter, bool removeFromInotify) {
+	/* a concurrent get() may rely on this watch while loading */
+	++generation;
+
+	if(removeFromInotify) {
+		inotify_rm_watch(inotifyFd, watchIter->second.wd);
+	}
+
+	std::vector<std::string> linkDirectories = std::move(watchIter->second.linkDirectories);
+	auto wdIter = directoryByWd.find(watchIter->second.wd);
+	if(wdIter != directoryByWd.end() && wdIter->second == watchIter->first) {
+		directoryByWd.erase(wdIter);
+	}
+	watchByDirectory.erase(watchIter);
+
+	for(const auto& linkDirectory : linkDirectories) {
+		auto linkWatchIter = watchByDirectory.find(linkDirectory);
+		if(linkWatchIter != watchByDirectory.end() && linkWatchIter->second.linkDependents > 0) {
+			--linkWatchIter->second.linkDependents;
+			removeWatchIfUnused(linkDirectory);
+		}
+	}
+}
+
+void FileCache::erase(std::list<Node>::iterator nodeIter) {
+	auto watchIter = watchByDirectory.find(nodeIter->directory);
+	if(watchIter != watchByDirectory.end()) {
+		watchIter->second.paths.erase(nodeIter->path);
+		if(watchIter->second.paths.empty()) {
+			removeWatchIfUnused(nodeIter->directory);
+		}
+	}
+
+	bytes -= nodeIter->bytes;
+	nodeByPath.erase(nodeIter->path);
+	(nodeIter->missing ? missingNodes : nodes).erase(nodeIter);
+}
+
+void FileCache::invalidateDirectory(const std::string& directory) {
+	++generation;
+
+	auto watchIter = watchByDirectory.find(directory);
+	if(watchIter == watchByDirectory.end()) {
+		return;
+	}
+
+	std::unordered_set<std::string> paths = std::move(watchIter->second.paths);
+	watchIter->second.paths.clear();
+
+	for(const auto& path : paths) {
+		auto nodeIter = nodeByPath.find(path);
+		if(nodeIter != nodeByPath.end()) {
+			erase(nodeIter->second);
+		}
+	}
+
+	removeWatchIfUnused(directory);
+}
+
+void FileCache::invalidatePath(const std::string& directory, const std::string& path) {
+	++generation;
+
+	/* the entry of the directory itself depends on its content, e.g. for default documents */
+	std::vector<std::string> invalidPaths = { directory, path };
+
+	/* missing entries below 'path' are watched by 'directory' as long as 'path' does not exist */
+	auto watchIter = watchByDirectory.find(directory);
+	if(watchIter != watchByDirectory.end()) {
+		std::string prefix = path + "/";
+		for(const auto& watchedPath : watchIter->second.paths) {
+			if(watchedPath.compare(0, prefix.size(), prefix) == 0) {
+				invalidPaths.push_back(watchedPath);
+			}
+		}
+	}
+
+	for(const auto& invalidPath : invalidPaths) {
+		auto nodeIter = nodeByPath.find(invalidPath);
+		if(nodeIter != nodeByPath.end()) {
+			erase(nodeIter->second);
+		}
+	}
+}
+
+void FileCache::invalidateTree(const std::string& directory) {
+	++generation;
+
+	/* inotify does not report a renamed or deleted ancestor to the watches of subdirectories */
+	std::string prefix = (directory == "/" ? directory : directory + "/");
+	std::vector<std::string> directories;
+	for(const auto& watch : watchByDirectory) {
+		if(watch.first == directory || watch.first.compare(0, prefix.size(), prefix) == 0) {
+			directories.push_back(watch.first);
+		}
+	}
+
+	for(const auto& treeDirectory : directories) {
+		invalidateDirectory(treeDirectory);
+	}
+}
+
+void FileCache::invalidateAll() {
+	++generation;
+
+	for(const auto& watch : watchByDirectory) {
+		inotify_rm_watch(inotifyFd, watch.second.wd);
+	}
+
+	watchByDirectory.clear();
+	directoryByWd.clear();
+	nodeByPath.clear();
+	nodes.clear();
+	missingNodes.clear();
+	bytes = 0;
+}
+
+void FileCache::runInotify() {
+	alignas(struct inotify_event) char buffer[16 * 1024];
+
+	while(!stopped) {
+		struct pollfd pollFd;
+		pollFd.fd = inotifyFd;
+		pollFd.events = POLLIN;
+		pollFd.revents = 0;
+
+		if(poll(&pollFd, 1, 500) <= 0) {
+			continue;
+		}
+
+		ssize_t length = read(inotifyFd, buffer, sizeof(buffer));
+		if(length <= 0) {
+			continue;
+		}
+
+		std::lock_guard<std::mutex> lock(mutex);
+		for(char* ptr = buffer; ptr < buffer + length; ) {
+			const struct inotify_event* event = reinterpret_cast<const struct inotify_event*>(ptr);
+			ptr += sizeof(struct inotify_event) + event->len;
+
+			if(event->mask & IN_Q_OVERFLOW) {
+				logger.debug << "inotify queue overflow, invalidate all entries.\n";
+				invalidateAll();
+				continue;
+			}
+
+			auto iter = directoryByWd.find(event->wd);
+			if(iter == directoryByWd.end()) {
+				continue;
+			}
+
+			/* copy because invalidation may remove the watch */
+			std::string directory = iter->second;
+			if(event->mask & IN_IGNORED) {
+				invalidateTree(directory);
+
+				/* the watch has been removed by the kernel already */
+				auto watchIter = watchByDirectory.find(directory);
+				if(watchIter != watchByDirectory.end()) {
+					removeWatch(watchIter, false);
+				}
+				continue;
+			}
+
+			if(event->len > 0 && (event->mask & (IN_DELETE_SELF | IN_MOVE_SELF)) == 0) {
+				std::string path = (directory == "/" ? directory : directory + "/") + event->name;
+				invalidatePath(directory, path);
+
+				/* a directory or symbolic link that has been renamed, replaced or deleted changes all paths below it */
+				if(event->mask & (IN_CREATE | IN_DELETE | IN_MOVED_FROM | IN_MOVED_TO)) {
+					invalidateTree(path);
+				}
+			}
+			else if(event->mask & (IN_DELETE_SELF | IN_MOVE_SELF)) {
+				invalidateTree(directory);
+			}
+			else {
+				invalidateDirectory(directory);
+			}
+		}
+	}
+}
+
+} /* namespace utility */
+} /* namespace openjerry */
@@ -0,0 +1,148 @@
+/*
+ * This file is part of Jerry application server.
+ * Copyright (C) 2020-2022 Sven Lukas
+ *
+ * Jerry is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as
+ * published by the Free Software Foundation, either version 3 of
+ * the License, or (at your option) any later version.
+ *
+ * Jerry is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public
+ * License along with Jerry.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#ifndef OPENJERRY_UTILITY_FILECACHE_H_
+#define OPENJERRY_UTILITY_FILECACHE_H_
+
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <list>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <unordered_map>
+#include <unordered_set>
+#include <vector>
+
+namespace openjerry {
+namespace utility {
+
+/* In-memory cache of file metadata and small file contents with a byte budget and LRU eviction.
+ * Cached entries are invalidated by inotify events of the directory that contains them, so a
+ * cache hit does not need any file system call. Missing paths are cached in a separate list
+ * bounded by a number of entries and watched by their nearest existing ancestor directory.
+ * If a watched directory is renamed, deleted or replaced, all entries below it are invalidated.
+ * Directories containing symbolic links of a watched path are watched as well, so switching
+ * a link to another release invalidates all entries below the link.
+ */
+class FileCache {
+public:
+	enum class Type {
+		notFound,
+		directory,
+		regularFile,
+		other
+	};
+
+	struct Entry {
+		Type type = Type::notFound;
+		std::uint64_t size = 0;
+		std::uint64_t device = 0;
+		std::uint64_t inode = 0;
+		std::chrono::system_clock::time_point lastModified;
+
+		/* strong validator and last modification time as HTTP-date of a regular file */
+		std::string etag;
+		std::string httpLastModified;
+
+		/* content of a regular file if it is not larger than the maximum content size, otherwise nullptr */
+		std::shared_ptr<const std::string> content;
+	};
+
+	/* 'maxBytes' is the budget of all entries, 'maxContentSize' the maximum size of a cached file content.
+	 * If 'contentHash' is true, the ETag is a hash of the content instead of inode, size and modification time.
+	 * 'maxMissingEntries' is the number of cached paths that do not exist. They have their own LRU list,
+	 * so many requests of missing paths do not evict existing files.
+	 */
+	FileCache(std::size_t maxBytes, std::size_t maxContentSize, bool contentHash = false, std::size_t maxMissingEntries = 0);
+	~FileCache();
+
+	std::shared_ptr<const Entry> get(const std::string& path);
+	void clear();
+
+	/* reads the metadata of 'path' and its content if it is not larger than 'maxContentSize' without using a cache */
+	static std::shared_ptr<const Entry> load(const std::string& path, std::size_t maxContentSize, bool contentHash = false);
+
+	std::uint64_t getHits() const noexcept;
+	std::uint64_t getMisses() const noexcept;
+
+private:
+	struct Node {
+		std::string path;
+		std::string directory;
+		bool missing;
+		std::size_t bytes;
+		std::shared_ptr<const Entry> entry;
+	};
+
+	struct Watch {
+		int wd;
+		std::unordered_set<std::string> paths;
+
+		/* number of watched directories with a symbolic link in this directory as part of their path */
+		std::size_t linkDependents = 0;
+
+		/* watched directories that contain the symbolic links of the path of this directory */
+		std::vector<std::string> linkDirectories;
+	};
+
+	const std::size_t maxBytes;
+	const std::size_t maxContentSize;
+	const bool contentHash;
+	const std::size_t maxMissingEntries;
+
+	std::mutex mutex;
+
+	/* most recently used node is at front */
+	std::list<Node> nodes;
+	std::list<Node> missingNodes;
+	std::unordered_map<std::string, std::list<Node>::iterator> nodeByPath;
+	std::size_t bytes = 0;
+
+	/* inotify watches of directories containing cached entries */
+	int inotifyFd = -1;
+	std::unordered_map<std::string, Watch> watchByDirectory;
+	std::unordered_map<int, std::string> directoryByWd;
+
+	/* incremented by every invalidation, entries loaded during an invalidation are not inserted */
+	std::uint64_t generation = 0;
+
+	std::atomic<bool> stopped{false};
+	std::thread inotifyThread;
+
+	std::atomic<std::uint64_t> hits{0};
+	std::atomic<std::uint64_t> misses{0};
+
+	bool addWatch(const std::string& directory);
+	void removeWatchIfUnused(const std::string& directory);
+	void removeWatch(std::unordered_map<std::string, Watch>::iterator watchIter, bool removeFromInotify);
+	void erase(std::list<Node>::iterator nodeIter);
+	void invalidateDirectory(const std::string& directory);
+	void invalidatePath(const std::string& directory, const std::string& path);
+	void invalidateTree(const std::string& directory);
+	void invalidateAll();
+	void runInotify();
+};
+
+} /* namespace utility */
+} /* namespace openjerry */
+
+#endif /* OPENJERRY_UTILITY_FILECACHE_H_ */
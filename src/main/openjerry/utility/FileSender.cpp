@@ -0,0 +1,648 @@
+/*
+ * This file is part of Jerry application server.
+ * Copyright (C) 2020-2022 Sven Lukas
+ *
+ * Jerry is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as
+ * published by the Free Software Foundation, either version 3 of
+ * the License, or (at your option) any later version.
+ *
+ * Jerry is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public
+ * License along with Jerry.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include <openjerry/utility/FileSender.h>
+#include <openjerry/utility/ContentProducer.h>
+#include <openjerry/utility/HttpDate.h>
+#include <openjerry/utility/MappedProducer.h>
+#include <openjerry/utility/MIME.h>
+#include <openjerry/utility/Number.h>
+#include <openjerry/utility/RangeProducer.h>
+#include <openjerry/Logger.h>
+
+#include <esl/com/http/server/Connection.h>
+#include <esl/io/output/String.h>
+#include <esl/utility/HttpMethod.h>
+#include <esl/utility/String.h>
+
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <random>
+#include <stdexcept>
+#include <vector>
+
+#include <strings.h>
+
+namespace openjerry {
+namespace utility {
+
+namespace {
+Logger logger("openjerry::utility::FileSender");
+
+/* weak comparison of an entity tag list as used by If-None-Match */
+bool isETagListMatch(const std::string& etagList, const std::string& etag) {
+	for(const auto& listEntry : esl::utility::String::split(etagList, ',')) {
+		std::string listETag = esl::utility::String::trim(listEntry);
+		if(listETag == "*") {
+			return true;
+		}
+		if(listETag.rfind("W/", 0) == 0) {
+			listETag = listETag.substr(2);
+		}
+		if(listETag == etag) {
+			return true;
+		}
+	}
+	return false;
+}
+
+struct Sidecar {
+	const char* encoding;
+	const char* extension;
+};
+
+/* compressed files next to the original file in order of preference */
+const Sidecar sidecars[] = {
+	{ "br", ".br" },
+	{ "gzip", ".gz" }
+};
+
+/* returns true if 'encoding' has a quality greater than zero in the Accept-Encoding header */
+bool isEncodingAccepted(const std::string& acceptEncoding, const std::string& encoding) {
+	bool wildcardAccepted = false;
+
+	for(const auto& listEntry : esl::utility::String::split(acceptEncoding, ',')) {
+		std::vector<std::string> tokens = esl::utility::String::split(listEntry, ';');
+		if(tokens.empty()) {
+			continue;
+		}
+
+		std::string name = esl::utility::String::toLower(esl::utility::String::trim(tokens.front()));
+		double quality = 1.0;
+		for(std::size_t i = 1; i < tokens.size(); ++i) {
+			std::string parameter = esl::utility::String::trim(tokens[i]);
+			if(parameter.size() > 2 && (parameter[0] == 'q' || parameter[0] == 'Q') && parameter[1] == '=') {
+				quality = std::strtod(parameter.c_str() + 2, nullptr);
+			}
+		}
+
+		if(name == encoding || (encoding == "gzip" && name == "x-gzip")) {
+			return quality > 0.0;
+		}
+		if(name == "*") {
+			wildcardAccepted = quality > 0.0;
+		}
+	}
+
+	return wildcardAccepted;
+}
+
+/* smaller files are not compressed on the fly */
+constexpr std::size_t compressMinFileSize = 256;
+
+/* encodings of on the fly compression in order of preference */
+const CompressionCache::Encoding compressEncodings[] = {
+	CompressionCache::Encoding::zstd,
+	CompressionCache::Encoding::gzip
+};
+
+bool isCompressible(const esl::utility::MIME& mime) {
+	std::string type = esl::utility::String::toLower(mime.toString());
+	std::string::size_type pos = type.find(';');
+	if(pos != std::string::npos) {
+		type = esl::utility::String::trim(type.substr(0, pos));
+	}
+
+	if(type.rfind("text/", 0) == 0) {
+		return true;
+	}
+	if(type.size() > 5 && (type.compare(type.size() - 5, 5, "+json") == 0 || type.compare(type.size() - 4, 4, "+xml") == 0)) {
+		return true;
+	}
+	return type == "application/javascript"
+			|| type == "application/x-javascript"
+			|| type == "application/json"
+			|| type == "application/xml"
+			|| type == "image/svg+xml";
+}
+
+/* more ranges are answered with the complete file */
+constexpr std::size_t maxRanges = 16;
+
+struct ByteRange {
+	std::size_t offset;
+	std::size_t size;
+};
+
+bool parseNumber(const std::string& str, std::size_t& value) {
+	if(str.empty() || str.size() > 19 || str.find_first_not_of("0123456789") != std::string::npos) {
+		return false;
+	}
+	value = static_cast<std::size_t>(std::stoull(str));
+	return true;
+}
+
+/* Parses a Range header for a file of 'fileSize' bytes. Returns false if the header is invalid
+ * and has to be ignored. Otherwise 'ranges' contains the satisfiable ranges sorted by offset
+ * with overlapping and adjacent ranges coalesced. It is empty if no range is satisfiable.
+ */
+bool parseRanges(const std::string& rangeHeader, std::size_t fileSize, std::vector<ByteRange>& ranges) {
+	std::string header = esl::utility::String::trim(rangeHeader);
+	if(header.size() < 6 || strncasecmp(header.c_str(), "bytes=", 6) != 0) {
+		return false;
+	}
+
+	for(const auto& rangeSpec : esl::utility::String::split(header.substr(6), ',')) {
+		std::string spec = esl::utility::String::trim(rangeSpec);
+		if(spec.empty()) {
+			continue;
+		}
+
+		std::string::size_type dashPos = spec.find('-');
+		if(dashPos == std::string::npos) {
+			return false;
+		}
+		std::string firstStr = esl::utility::String::trim(spec.substr(0, dashPos));
+		std::string lastStr = esl::utility::String::trim(spec.substr(dashPos + 1));
+		std::size_t first = 0;
+		std::size_t last = 0;
+
+		if(firstStr.empty()) {
+			/* suffix range "-N" */
+			if(!parseNumber(lastStr, last)) {
+				return false;
+			}
+			if(last > 0 && fileSize > 0) {
+				std::size_t size = std::min(last, fileSize);
+				ranges.push_back(ByteRange{fileSize - size, size});
+			}
+			continue;
+		}
+
+		if(!parseNumber(firstStr, first)) {
+			return false;
+		}
+		if(lastStr.empty()) {
+			last = fileSize;
+		}
+		else if(!parseNumber(lastStr, last) || last < first) {
+			return false;
+		}
+
+		if(first < fileSize) {
+			last = std::min(last, fileSize - 1);
+			ranges.push_back(ByteRange{first, last - first + 1});
+		}
+	}
+
+	std::sort(ranges.begin(), ranges.end(), [](const ByteRange& a, const ByteRange& b) {
+		return a.offset < b.offset;
+	});
+
+	std::vector<ByteRange> coalescedRanges;
+	for(const auto& range : ranges) {
+		if(!coalescedRanges.empty() && range.offset <= coalescedRanges.back().offset + coalescedRanges.back().size) {
+			ByteRange& previous = coalescedRanges.back();
+			previous.size = std::max(previous.offset + previous.size, range.offset + range.size) - previous.offset;
+		}
+		else {
+			coalescedRanges.push_back(range);
+		}
+	}
+	ranges = std::move(coalescedRanges);
+
+	return ranges.size() <= maxRanges;
+}
+
+std::string toContentRange(const ByteRange& range, std::size_t fileSize) {
+	return "bytes " + std::to_string(range.offset) + "-" + std::to_string(range.offset + range.size - 1) + "/" + std::to_string(fileSize);
+}
+
+std::string createBoundary() {
+	thread_local std::mt19937_64 generator(std::random_device{}());
+	char buffer[17];
+	std::snprintf(buffer, sizeof(buffer), "%016llx", static_cast<unsigned long long>(generator()));
+	return std::string("openjerry-") + buffer;
+}
+} /* anonymous namespace */
+
+bool FileSender::addSetting(const std::string& key, const std::string& value) {
+	if(key == "cache-size") {
+		if(hasCacheSize) {
+			throw std::runtime_error("Multiple definition of attribute 'cache-size'");
+		}
+		hasCacheSize = true;
+		cacheSize = Number::toNumber(key, value);
+	}
+	else if(key == "cache-max-file-size") {
+		if(hasCacheMaxFileSize) {
+			throw std::runtime_error("Multiple definition of attribute 'cache-max-file-size'");
+		}
+		hasCacheMaxFileSize = true;
+		cacheMaxFileSize = Number::toNumber(key, value);
+	}
+	else if(key == "negative-cache-size") {
+		if(hasNegativeCacheSize) {
+			throw std::runtime_error("Multiple definition of attribute 'negative-cache-size'");
+		}
+		hasNegativeCacheSize = true;
+		negativeCacheSize = Number::toNumber(key, value);
+	}
+	else if(key == "mmap-cache-size") {
+		if(hasMmapCacheSize) {
+			throw std::runtime_error("Multiple definition of attribute 'mmap-cache-size'");
+		}
+		hasMmapCacheSize = true;
+		mmapCacheSize = Number::toNumber(key, value);
+	}
+	else if(key == "mmap-max-file-size") {
+		if(hasMmapMaxFileSize) {
+			throw std::runtime_error("Multiple definition of attribute 'mmap-max-file-size'");
+		}
+		hasMmapMaxFileSize = true;
+		mmapMaxFileSize = Number::toNumber(key, value);
+	}
+	else if(key == "cache-control") {
+		cachePolicy.addRule(value);
+	}
+	else if(key == "precompressed") {
+		if(hasPrecompressed) {
+			throw std::runtime_error("Multiple definition of attribute 'precompressed'");
+		}
+		hasPrecompressed = true;
+		if(value == "true") {
+			precompressed = true;
+		}
+		else if(value == "false") {
+			precompressed = false;
+		}
+		else {
+			throw std::runtime_error("Unknown value \"" + value + "\" for parameter key=\"" + key + "\". Possible values are \"true\" or \"false\".");
+		}
+	}
+	else if(key == "compress") {
+		if(hasCompress) {
+			throw std::runtime_error("Multiple definition of attribute 'compress'");
+		}
+		hasCompress = true;
+		if(value == "true") {
+			compress = true;
+		}
+		else if(value == "false") {
+			compress = false;
+		}
+		else {
+			throw std::runtime_error("Unknown value \"" + value + "\" for parameter key=\"" + key + "\". Possible values are \"true\" or \"false\".");
+		}
+	}
+	else if(key == "compress-cache-size") {
+		if(hasCompressCacheSize) {
+			throw std::runtime_error("Multiple definition of attribute 'compress-cache-size'");
+		}
+		hasCompressCacheSize = true;
+		compressCacheSize = Number::toNumber(key, value);
+	}
+	else if(key == "compress-max-file-size") {
+		if(hasCompressMaxFileSize) {
+			throw std::runtime_error("Multiple definition of attribute 'compress-max-file-size'");
+		}
+		hasCompressMaxFileSize = true;
+		compressMaxFileSize = Number::toNumber(key, value);
+	}
+	else if(key == "etag") {
+		if(hasETag) {
+			throw std::runtime_error("Multiple definition of attribute 'etag'");
+		}
+		hasETag = true;
+		if(value == "metadata") {
+			etag = ETag::metadata;
+		}
+		else if(value == "content") {
+			etag = ETag::content;
+		}
+		else if(value == "none") {
+			etag = ETag::none;
+		}
+		else {
+			throw std::runtime_error("Unknown value \"" + value + "\" for parameter key=\"" + key + "\". Possible values are \"metadata\", \"content\" or \"none\".");
+		}
+	}
+	else {
+		return false;
+	}
+
+	return true;
+}
+
+void FileSender::initialize() {
+	/* missing paths are cached as well if there is a file cache, unless 'negative-cache-size' is 0 */
+	if(cacheSize > 0 || (hasNegativeCacheSize && negativeCacheSize > 0)) {
+		fileCache.reset(new FileCache(cacheSize, cacheMaxFileSize, etag == ETag::content, negativeCacheSize));
+	}
+	else if(hasCacheMaxFileSize) {
+		throw std::runtime_error("Parameter 'cache-max-file-size' requires parameter 'cache-size'");
+	}
+	else if(etag == ETag::content) {
+		logger.warn << "ETag of file contents is calculated for every request, because parameter 'cache-size' is not set.\n";
+	}
+
+	if(mmapCacheSize > 0) {
+		mappedFileCache.reset(new MappedFileCache(mmapCacheSize, mmapMaxFileSize));
+	}
+	else if(hasMmapMaxFileSize) {
+		throw std::runtime_error("Parameter 'mmap-max-file-size' requires parameter 'mmap-cache-size'");
+	}
+
+	if(compress) {
+		compressionCache.reset(new CompressionCache(compressCacheSize, compressMaxFileSize));
+	}
+	else if(hasCompressCacheSize || hasCompressMaxFileSize) {
+		throw std::runtime_error("Parameters 'compress-cache-size' and 'compress-max-file-size' require parameter 'compress' to be \"true\"");
+	}
+}
+
+bool FileSender::hasContentCache() const noexcept {
+	return fileCache && cacheSize > 0;
+}
+
+std::shared_ptr<const FileCache::Entry> FileSender::getEntry(const std::string& path) const {
+	if(fileCache) {
+		return fileCache->get(path);
+	}
+	return FileCache::load(path, 0, etag == ETag::content);
+}
+
+void FileSender::preload(const std::string& path) const {
+	std::shared_ptr<const FileCache::Entry> entry = getEntry(path);
+	if(entry->type != FileCache::Type::regularFile) {
+		return;
+	}
+
+	if(precompressed) {
+		for(const auto& sidecar : sidecars) {
+			std::shared_ptr<const FileCache::Entry> sidecarEntry = getEntry(path + sidecar.extension);
+			if(sidecarEntry->type == FileCache::Type::regularFile) {
+				getMapping(path + sidecar.extension, *sidecarEntry);
+			}
+		}
+	}
+
+	if(compressionCache && entry->size >= compressMinFileSize && isCompressible(MIME::byFilename(path))) {
+		for(auto encoding : compressEncodings) {
+			if(CompressionCache::isSupported(encoding)) {
+				compressionCache->get(path, *entry, encoding);
+			}
+		}
+	}
+
+	getMapping(path, *entry);
+}
+
+void FileSender::setRoot(const std::string& aRoot) {
+	root = aRoot;
+	while(!root.empty() && root.back() == '/') {
+		root.pop_back();
+	}
+}
+
+void FileSender::send(esl::com::http::server::RequestContext& requestContext, unsigned short statusCode, const std::string& path, const FileCache::Entry& entry) const {
+	/* the content type is always the type of the original file, even if a compressed file is sent */
+	esl::utility::MIME mime = MIME::byFilename(path);
+
+	/* the cache policy is selected by the original file as well, by its path relative to the root like "/assets/app.js" */
+	const CachePolicy::Rule* cacheRule = nullptr;
+	if(statusCode == 200 && !cachePolicy.empty()) {
+		if(!root.empty() && path.size() > root.size() && path.compare(0, root.size(), root) == 0 && path[root.size()] == '/') {
+			cacheRule = cachePolicy.find(path.substr(root.size()), mime);
+		}
+		else {
+			cacheRule = cachePolicy.find(path, mime);
+		}
+	}
+
+	if(statusCode == 200 && precompressed) {
+		const std::string* acceptEncoding = findHeader(requestContext.getRequest(), "Accept-Encoding");
+		if(acceptEncoding) {
+			for(const auto& sidecar : sidecars) {
+				if(!isEncodingAccepted(*acceptEncoding, sidecar.encoding)) {
+					continue;
+				}
+
+				std::string sidecarPath = path + sidecar.extension;
+				std::shared_ptr<const FileCache::Entry> sidecarEntry = getEntry(sidecarPath);
+
+				/* a compressed file older than the original file is outdated and not used */
+				if(sidecarEntry->type == FileCache::Type::regularFile && sidecarEntry->lastModified >= entry.lastModified) {
+					sendEntry(requestContext, statusCode, mime, sidecarPath, *sidecarEntry, sidecar.encoding, cacheRule);
+					return;
+				}
+			}
+		}
+	}
+
+	if(statusCode == 200 && compressionCache && entry.size >= compressMinFileSize && isCompressible(mime)) {
+		const std::string* acceptEncoding = findHeader(requestContext.getRequest(), "Accept-Encoding");
+		if(acceptEncoding) {
+			for(auto encoding : compressEncodings) {
+				if(!CompressionCache::isSupported(encoding) || !isEncodingAccepted(*acceptEncoding, CompressionCache::toString(encoding))) {
+					continue;
+				}
+
+				std::shared_ptr<const FileCache::Entry> variant = compressionCache->get(path, entry, encoding);
+				if(variant) {
+					sendEntry(requestContext, statusCode, mime, path, *variant, CompressionCache::toString(encoding), cacheRule);
+					return;
+				}
+				break;
+			}
+		}
+	}
+
+	sendEntry(requestContext, statusCode, mime, path, entry, nullptr, cacheRule);
+}
+
+void FileSender::sendEntry(esl::com::http::server::RequestContext& requestContext, unsigned short statusCode, const esl::utility::MIME& mime, const std::string& path, const FileCache::Entry& entry, const char* contentEncoding, const CachePolicy::Rule* cacheRule) const {
+	/* validators are only used for the file itself, not if it is sent as content of an error */
+	bool useValidators = (statusCode == 200 && etag != ETag::none);
+
+	if(useValidators && isNotModified(requestContext.getRequest(), entry)) {
+		esl::com::http::server::Response response(304, mime);
+		addValidators(response, entry);
+		addHeaders(response, contentEncoding, cacheRule);
+		requestContext.getConnection().send(response, esl::io::output::String::create(std::string()));
+		return;
+	}
+
+	/* ranges are only used for the file itself, not if it is sent as content of an error */
+	if(statusCode == 200) {
+		const esl::com::http::server::Request& request = requestContext.getRequest();
+		const std::string* rangeHeader = findHeader(request, "Range");
+		std::vector<ByteRange> ranges;
+
+		if(rangeHeader && request.getMethod() == esl::utility::HttpMethod::Type::httpGet
+				&& isIfRangeMatch(request, entry) && parseRanges(*rangeHeader, entry.size, ranges)) {
+			if(ranges.empty()) {
+				esl::com::http::server::Response response(416, mime);
+				response.addHeader("Content-Range", "bytes */" + std::to_string(entry.size));
+				requestContext.getConnection().send(response, esl::io::output::String::create(std::string()));
+				return;
+			}
+
+			std::unique_ptr<RangeProducer> rangeProducer;
+			std::shared_ptr<const MappedFileCache::Mapping> mapping = getMapping(path, entry);
+			if(entry.content) {
+				rangeProducer.reset(new RangeProducer(path, entry.content));
+			}
+			else if(mapping) {
+				rangeProducer.reset(new RangeProducer(path, std::move(mapping)));
+			}
+			else {
+				rangeProducer.reset(new RangeProducer(path));
+			}
+
+			if(ranges.size() == 1) {
+				esl::com::http::server::Response response(206, mime);
+				if(useValidators) {
+					addValidators(response, entry);
+				}
+				addHeaders(response, contentEncoding, cacheRule);
+				response.addHeader("Accept-Ranges", "bytes");
+				response.addHeader("Content-Range", toContentRange(ranges.front(), entry.size));
+				rangeProducer->addRange(ranges.front().offset, ranges.front().size);
+				requestContext.getConnection().send(response, RangeProducer::create(std::move(rangeProducer)));
+				return;
+			}
+
+			std::string boundary = createBoundary();
+			esl::com::http::server::Response response(206, esl::utility::MIME("multipart/byteranges; boundary=" + boundary));
+			if(useValidators) {
+				addValidators(response, entry);
+			}
+			addHeaders(response, contentEncoding, cacheRule);
+			response.addHeader("Accept-Ranges", "bytes");
+			for(const auto& range : ranges) {
+				rangeProducer->addText("\r\n--" + boundary + "\r\n"
+						"Content-Type: " + mime.toString() + "\r\n"
+						"Content-Range: " + toContentRange(range, entry.size) + "\r\n\r\n");
+				rangeProducer->addRange(range.offset, range.size);
+			}
+			rangeProducer->addText("\r\n--" + boundary + "--\r\n");
+			requestContext.getConnection().send(response, RangeProducer::create(std::move(rangeProducer)));
+			return;
+		}
+	}
+
+	esl::com::http::server::Response response(statusCode, mime);
+	if(useValidators) {
+		addValidators(response, entry);
+	}
+	if(statusCode == 200) {
+		addHeaders(response, contentEncoding, cacheRule);
+		response.addHeader("Accept-Ranges", "bytes");
+	}
+
+	std::shared_ptr<const MappedFileCache::Mapping> mapping = getMapping(path, entry);
+	if(entry.content) {
+		requestContext.getConnection().send(response, ContentProducer::create(entry.content));
+	}
+	else if(mapping) {
+		requestContext.getConnection().send(response, MappedProducer::create(std::move(mapping)));
+	}
+	else {
+		requestContext.getConnection().sendFile(response, path);
+	}
+}
+
+std::shared_ptr<const MappedFileCache::Mapping> FileSender::getMapping(const std::string& path, const FileCache::Entry& entry) const {
+	if(entry.content || !mappedFileCache) {
+		return nullptr;
+	}
+	return mappedFileCache->get(path, entry);
+}
+
+const std::string* FileSender::findHeader(const esl::com::http::server::Request& request, const std::string& name) {
+	for(const auto& header : request.getHeaders()) {
+		if(header.first.size() == name.size() && strcasecmp(header.first.c_str(), name.c_str()) == 0) {
+			return &header.second;
+		}
+	}
+	return nullptr;
+}
+
+bool FileSender::isNotModified(const esl::com::http::server::Request& request, const FileCache::Entry& entry) const {
+	if(request.getMethod() != esl::utility::HttpMethod::Type::httpGet && request.getMethod() != esl::utility::HttpMethod::Type::httpHead) {
+		return false;
+	}
+
+	/* If-Modified-Since is ignored if If-None-Match is present */
+	const std::string* ifNoneMatch = findHeader(request, "If-None-Match");
+	if(ifNoneMatch) {
+		return isETagListMatch(*ifNoneMatch, entry.etag);
+	}
+
+	const std::string* ifModifiedSince = findHeader(request, "If-Modified-Since");
+	if(ifModifiedSince) {
+		std::chrono::system_clock::time_point timePoint;
+		if(HttpDate::fromString(*ifModifiedSince, timePoint)) {
+			return std::chrono::floor<std::chrono::seconds>(entry.lastModified) <= timePoint;
+		}
+	}
+
+	return false;
+}
+
+bool FileSender::isIfRangeMatch(const esl::com::http::server::Request& request, const FileCache::Entry& entry) const {
+	const std::string* ifRange = findHeader(request, "If-Range");
+	if(!ifRange) {
+		return true;
+	}
+
+	/* If-Range needs a validator that is sent to the client as well */
+	if(etag == ETag::none) {
+		return false;
+	}
+
+	std::string value = esl::utility::String::trim(*ifRange);
+
+	/* entity tags are compared strong, so a weak entity tag never matches */
+	if(!value.empty() && value.front() == '"') {
+		return value == entry.etag;
+	}
+	if(value.rfind("W/", 0) == 0) {
+		return false;
+	}
+
+	std::chrono::system_clock::time_point timePoint;
+	if(HttpDate::fromString(value, timePoint)) {
+		return std::chrono::floor<std::chrono::seconds>(entry.lastModified) == timePoint;
+	}
+
+	return false;
+}
+
+void FileSender::addHeaders(esl::com::http::server::Response& response, const char* contentEncoding, const CachePolicy::Rule* cacheRule) const {
+	if(cacheRule) {
+		cacheRule->addHeaders(response);
+	}
+	if(precompressed || compressionCache) {
+		response.addHeader("Vary", "Accept-Encoding");
+	}
+	if(contentEncoding) {
+		response.addHeader("Content-Encoding", contentEncoding);
+	}
+}
+
+void FileSender::addValidators(esl::com::http::server::Response& response, const FileCache::Entry& entry) const {
+	response.addHeader("ETag", entry.etag);
+	response.addHeader("Last-Modified", entry.httpLastModified);
+}
+
+} /* namespace utility */
+} /* namespace openjerry */
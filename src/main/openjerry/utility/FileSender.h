@@ -0,0 +1,128 @@
+/*
+ * This file is part of Jerry application server.
+ * Copyright (C) 2020-2022 Sven Lukas
+ *
+ * Jerry is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as
+ * published by the Free Software Foundation, either version 3 of
+ * the License, or (at your option) any later version.
+ *
+ * Jerry is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public
+ * License along with Jerry.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#ifndef OPENJERRY_UTILITY_FILESENDER_H_
+#define OPENJERRY_UTILITY_FILESENDER_H_
+
+#include <openjerry/utility/CachePolicy.h>
+#include <openjerry/utility/CompressionCache.h>
+#include <openjerry/utility/FileCache.h>
+#include <openjerry/utility/MappedFileCache.h>
+
+#include <esl/com/http/server/Request.h>
+#include <esl/com/http/server/RequestContext.h>
+#include <esl/com/http/server/Response.h>
+#include <esl/utility/MIME.h>
+
+#include <cstddef>
+#include <memory>
+#include <string>
+
+namespace openjerry {
+namespace utility {
+
+/* Sends files for the static file handlers jerry/file and jerry/filebrowser, including
+ * the optional file and mapping caches, validators for conditional requests, byte ranges,
+ * precompressed files, compression on the fly and cache policy headers.
+ */
+class FileSender {
+public:
+	/* returns false if 'key' is not a parameter of the file sender */
+	bool addSetting(const std::string& key, const std::string& value);
+
+	/* has to be called after all settings have been added */
+	void initialize();
+
+	/* directory served by the handler, path rules of 'cache-control' are matched against the path relative to it */
+	void setRoot(const std::string& root);
+
+	/* returns true if file contents are cached, i.e. 'cache-size' is set */
+	bool hasContentCache() const noexcept;
+
+	std::shared_ptr<const FileCache::Entry> getEntry(const std::string& path) const;
+
+	/* loads metadata, content, compressed variants and mapping of 'path' into the caches */
+	void preload(const std::string& path) const;
+
+	/* sends the regular file 'path' with the metadata 'entry' */
+	void send(esl::com::http::server::RequestContext& requestContext, unsigned short statusCode, const std::string& path, const FileCache::Entry& entry) const;
+
+	/* returns the value of a request header with case insensitive name or nullptr */
+	static const std::string* findHeader(const esl::com::http::server::Request& request, const std::string& name);
+
+private:
+	enum class ETag {
+		none,
+		metadata,
+		content
+	};
+
+	/* optional cache of metadata and small contents, 'cache-size' is the budget in bytes */
+	std::size_t cacheSize = 0;
+	bool hasCacheSize = false;
+	std::size_t cacheMaxFileSize = 64 * 1024;
+	bool hasCacheMaxFileSize = false;
+	/* number of cached missing paths, they are cached without 'cache-size' as well if it is set */
+	std::size_t negativeCacheSize = 4096;
+	bool hasNegativeCacheSize = false;
+	std::unique_ptr<FileCache> fileCache;
+
+	/* Optional cache of memory mappings of files not cached by the file cache, 'mmap-cache-size' is the budget in bytes.
+	 * It is disabled by default, because files must be replaced, e.g. by rename, instead of being rewritten in place:
+	 * reading a mapping of a file that has been truncated while it is sent raises SIGBUS.
+	 */
+	std::size_t mmapCacheSize = 0;
+	bool hasMmapCacheSize = false;
+	std::size_t mmapMaxFileSize = 16 * 1024 * 1024;
+	bool hasMmapMaxFileSize = false;
+	std::unique_ptr<MappedFileCache> mappedFileCache;
+
+	ETag etag = ETag::metadata;
+	bool hasETag = false;
+
+	/* rules of parameters 'cache-control' in order of definition */
+	CachePolicy cachePolicy;
+	std::string root;
+
+	/* send 'file.br' or 'file.gz' instead of 'file' if the client accepts the encoding */
+	bool precompressed = false;
+	bool hasPrecompressed = false;
+
+	/* compress text files on the fly if there is no precompressed file, 'compress-cache-size' is the budget in bytes */
+	bool compress = false;
+	bool hasCompress = false;
+	std::size_t compressCacheSize = 16 * 1024 * 1024;
+	bool hasCompressCacheSize = false;
+	std::size_t compressMaxFileSize = 1024 * 1024;
+	bool hasCompressMaxFileSize = false;
+	std::unique_ptr<CompressionCache> compressionCache;
+
+	void sendEntry(esl::com::http::server::RequestContext& requestContext, unsigned short statusCode, const esl::utility::MIME& mime, const std::string& path, const FileCache::Entry& entry, const char* contentEncoding, const CachePolicy::Rule* cacheRule) const;
+
+	bool isNotModified(const esl::com::http::server::Request& request, const FileCache::Entry& entry) const;
+	bool isIfRangeMatch(const esl::com::http::server::Request& request, const FileCache::Entry& entry) const;
+	std::shared_ptr<const MappedFileCache::Mapping> getMapping(const std::string& path, const FileCache::Entry& entry) const;
+	/* adds the headers of a representation of the file, that are sent with 200, 206 and 304 */
+	void addHeaders(esl::com::http::server::Response& response, const char* contentEncoding, const CachePolicy::Rule* cacheRule) const;
+	void addValidators(esl::com::http::server::Response& response, const FileCache::Entry& entry) const;
+};
+
+} /* namespace utility */
+} /* namespace openjerry */
+
+#endif /* OPENJERRY_UTILITY_FILESENDER_H_ */
@@ -0,0 +1,81 @@
+/*
+ * This file is part of Jerry application server.
+ * Copyright (C) 2020-2022 Sven Lukas
+ *
+ * Jerry is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as
+ * published by the Free Software Foundation, either version 3 of
+ * the License, or (at your option) any later version.
+ *
+ * Jerry is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public
+ * License along with Jerry.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include <openjerry/utility/FrequencySketch.h>
+
+#include <algorithm>
+
+namespace openjerry {
+namespace utility {
+
+namespace {
+const std::uint64_t seeds[] = {
+		0xc3a5c85c97cb3127ULL,
+		0xb492b66fbe98f273ULL,
+		0x9ae16a3b2f90404fULL,
+		0xcbf29ce484222325ULL
+};
+} /* anonymous namespace */
+
+FrequencySketch::FrequencySketch(std::size_t maxEntries)
+: width(16)
+{
+	/* width is a power of two, so the index of a counter is a mask of the hash */
+	while(width < maxEntries) {
+		width *= 2;
+	}
+	counters.resize(depth * width, 0);
+	sampleSize = 10 * width;
+}
+
+void FrequencySketch::increment(std::uint64_t hash) noexcept {
+	for(unsigned int row = 0; row < depth; ++row) {
+		std::uint8_t& counter = counters[getIndex(hash, row)];
+		if(counter < maxCount) {
+			++counter;
+		}
+	}
+
+	if(++additions >= sampleSize) {
+		age();
+	}
+}
+
+unsigned int FrequencySketch::estimate(std::uint64_t hash) const noexcept {
+	unsigned int count = maxCount;
+	for(unsigned int row = 0; row < depth; ++row) {
+		count = std::min<unsigned int>(count, counters[getIndex(hash, row)]);
+	}
+	return count;
+}
+
+std::size_t FrequencySketch::getIndex(std::uint64_t hash, unsigned int row) const noexcept {
+	std::uint64_t value = (hash + seeds[row]) * 0x9e3779b97f4a7c15ULL;
+	value ^= value >> 32;
+	return row * width + (value & (width - 1));
+}
+
+void FrequencySketch::age() noexcept {
+	for(std::uint8_t& counter : counters) {
+		counter /= 2;
+	}
+	additions /= 2;
+}
+
+} /* namespace utility */
+} /* namespace openjerry */
@@ -0,0 +1,57 @@
+/*
+ * This file is part of Jerry application server.
+ * Copyright (C) 2020-2022 Sven Lukas
+ *
+ * Jerry is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as
+ * published by the Free Software Foundation, either version 3 of
+ * the License, or (at your option) any later version.
+ *
+ * Jerry is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public
+ * License along with Jerry.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#ifndef OPENJERRY_UTILITY_FREQUENCYSKETCH_H_
+#define OPENJERRY_UTILITY_FREQUENCYSKETCH_H_
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace openjerry {
+namespace utility {
+
+/* Count-min sketch that estimates how often a key has been accessed recently, as it is used by
+ * TinyLFU admission. Counters saturate at 15 and all counters are halved after a sample of
+ * 10 accesses per counter, so old popularity fades out.
+ */
+class FrequencySketch {
+public:
+	/* 'maxEntries' is the capacity of the cache that uses the sketch */
+	explicit FrequencySketch(std::size_t maxEntries);
+
+	void increment(std::uint64_t hash) noexcept;
+	unsigned int estimate(std::uint64_t hash) const noexcept;
+
+private:
+	static constexpr unsigned int depth = 4;
+	static constexpr std::uint8_t maxCount = 15;
+
+	std::size_t width;
+	std::vector<std::uint8_t> counters;
+	std::size_t additions = 0;
+	std::size_t sampleSize;
+
+	std::size_t getIndex(std::uint64_t hash, unsigned int row) const noexcept;
+	void age() noexcept;
+};
+
+} /* namespace utility */
+} /* namespace openjerry */
+
+#endif /* OPENJERRY_UTILITY_FREQUENCYSKETCH_H_ */
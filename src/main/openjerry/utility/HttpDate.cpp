@@ -0,0 +1,76 @@
+/*
+ * This file is part of Jerry application server.
+ * Copyright (C) 2020-2022 Sven Lukas
+ *
+ * Jerry is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as
+ * published by the Free Software Foundation, either version 3 of
+ * the License, or (at your option) any later version.
+ *
+ * Jerry is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public
+ * License along with Jerry.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include <openjerry/utility/HttpDate.h>
+
+#include <cstdio>
+#include <cstring>
+#include <ctime>
+
+namespace openjerry {
+namespace utility {
+namespace {
+
+/* names are written explicitly, because strftime and strptime are depending on the locale */
+const char* const dayNames[] = { "Sun", "Mon", "Tue", "Wed", "Thu", "Fri", "Sat" };
+const char* const monthNames[] = { "Jan", "Feb", "Mar", "Apr", "May", "Jun", "Jul", "Aug", "Sep", "Oct", "Nov", "Dec" };
+
+} /* anonymous namespace */
+
+std::string HttpDate::toString(std::chrono::system_clock::time_point timePoint) {
+	std::time_t time = std::chrono::system_clock::to_time_t(timePoint);
+	std::tm tm;
+	char buffer[64];
+
+	gmtime_r(&time, &tm);
+	int size = std::snprintf(buffer, sizeof(buffer), "%s, %02d %s %04d %02d:%02d:%02d GMT",
+			dayNames[tm.tm_wday], tm.tm_mday, monthNames[tm.tm_mon], tm.tm_year + 1900, tm.tm_hour, tm.tm_min, tm.tm_sec);
+
+	return std::string(buffer, size > 0 ? static_cast<std::size_t>(size) : 0);
+}
+
+bool HttpDate::fromString(const std::string& str, std::chrono::system_clock::time_point& timePoint) {
+	char dayName[4];
+	char monthName[4];
+	int consumed = 0;
+	std::tm tm;
+
+	std::memset(&tm, 0, sizeof(tm));
+	if(std::sscanf(str.c_str(), "%3s, %2d %3s %4d %2d:%2d:%2d GMT%n", dayName, &tm.tm_mday, monthName, &tm.tm_year, &tm.tm_hour, &tm.tm_min, &tm.tm_sec, &consumed) != 7
+			|| consumed == 0 || static_cast<std::size_t>(consumed) != str.size()) {
+		return false;
+	}
+
+	tm.tm_mon = -1;
+	for(int month = 0; month < 12; ++month) {
+		if(std::strcmp(monthName, monthNames[month]) == 0) {
+			tm.tm_mon = month;
+			break;
+		}
+	}
+	if(tm.tm_mon < 0) {
+		return false;
+	}
+	tm.tm_year -= 1900;
+
+	timePoint = std::chrono::system_clock::from_time_t(timegm(&tm));
+	return true;
+}
+
+} /* namespace utility */
+} /* namespace openjerry */
@@ -0,0 +1,41 @@
+/*
+ * This file is part of Jerry application server.
+ * Copyright (C) 2020-2022 Sven Lukas
+ *
+ * Jerry is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as
+ * published by the Free Software Foundation, either version 3 of
+ * the License, or (at your option) any later version.
+ *
+ * Jerry is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public
+ * License along with Jerry.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#ifndef OPENJERRY_UTILITY_HTTPDATE_H_
+#define OPENJERRY_UTILITY_HTTPDATE_H_
+
+#include <chrono>
+#include <string>
+
+namespace openjerry {
+namespace utility {
+
+struct HttpDate final {
+	HttpDate() = delete;
+
+	/* formats 'timePoint' as IMF-fixdate, e.g. "Sun, 06 Nov 1994 08:49:37 GMT" */
+	static std::string toString(std::chrono::system_clock::time_point timePoint);
+
+	/* parses an IMF-fixdate and returns false if 'str' is not a valid date */
+	static bool fromString(const std::string& str, std::chrono::system_clock::time_point& timePoint);
+};
+
+} /* namespace utility */
+} /* namespace openjerry */
+
+#endif /* OPENJERRY_UTILITY_HTTPDATE_H_ */
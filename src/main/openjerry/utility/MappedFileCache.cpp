@@ -0,0 +1,147 @@
+/*
+ * This file is part of Jerry application server.
+ * Copyright (C) 2020-2022 Sven Lukas
+ *
+ * Jerry is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as
+ * published by the Free Software Foundation, either version 3 of
+ * the License, or (at your option) any later version.
+ *
+ * Jerry is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public
+ * License along with Jerry.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include <openjerry/utility/MappedFileCache.h>
+#include <openjerry/Logger.h>
+
+#include <cerrno>
+#include <cstring>
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+namespace openjerry {
+namespace utility {
+
+namespace {
+Logger logger("openjerry::utility::MappedFileCache");
+} /* anonymous namespace */
+
+MappedFileCache::Mapping::Mapping(const void* aData, std::size_t aSize)
+: data(aData),
+  size(aSize)
+{ }
+
+MappedFileCache::Mapping::~Mapping() {
+	munmap(const_cast<void*>(data), size);
+}
+
+const char* MappedFileCache::Mapping::getData() const noexcept {
+	return static_cast<const char*>(data);
+}
+
+std::size_t MappedFileCache::Mapping::getSize() const noexcept {
+	return size;
+}
+
+MappedFileCache::MappedFileCache(std::size_t aMaxBytes, std::size_t aMaxFileSize)
+: maxBytes(aMaxBytes),
+  maxFileSize(aMaxFileSize)
+{ }
+
+std::shared_ptr<const MappedFileCache::Mapping> MappedFileCache::get(const std::string& path, const FileCache::Entry& entry) {
+	if(entry.type != FileCache::Type::regularFile || entry.size == 0 || entry.size > maxFileSize || entry.size > maxBytes) {
+		return nullptr;
+	}
+
+	{
+		std::lock_guard<std::mutex> lock(mutex);
+
+		auto iter = nodeByPath.find(path);
+		if(iter != nodeByPath.end()) {
+			if(iter->second->inode == entry.inode && iter->second->size == entry.size && iter->second->lastModified == entry.lastModified) {
+				nodes.splice(nodes.begin(), nodes, iter->second);
+				hits.fetch_add(1, std::memory_order_relaxed);
+				return iter->second->mapping;
+			}
+			erase(iter->second);
+		}
+	}
+
+	misses.fetch_add(1, std::memory_order_relaxed);
+
+	std::shared_ptr<const Mapping> mapping = map(path, entry);
+	if(!mapping) {
+		return nullptr;
+	}
+
+	std::lock_guard<std::mutex> lock(mutex);
+
+	auto iter = nodeByPath.find(path);
+	if(iter != nodeByPath.end()) {
+		erase(iter->second);
+	}
+
+	while(!nodes.empty() && bytes + mapping->getSize() > maxBytes) {
+		erase(std::prev(nodes.end()));
+	}
+
+	bytes += mapping->getSize();
+	nodes.push_front(Node{path, entry.inode, entry.size, entry.lastModified, mapping});
+	nodeByPath[path] = nodes.begin();
+
+	return mapping;
+}
+
+std::shared_ptr<const MappedFileCache::Mapping> MappedFileCache::map(const std::string& path, const FileCache::Entry& entry) {
+	int fd = open(path.c_str(), O_RDONLY | O_CLOEXEC);
+	if(fd < 0) {
+		return nullptr;
+	}
+
+	/* the file might have been replaced since 'entry' has been loaded */
+	struct stat fileStat;
+	if(fstat(fd, &fileStat) != 0
+			|| static_cast<std::uint64_t>(fileStat.st_ino) != entry.inode
+			|| static_cast<std::uint64_t>(fileStat.st_size) != entry.size
+			|| fileStat.st_size == 0
+			|| std::chrono::system_clock::time_point(std::chrono::duration_cast<std::chrono::system_clock::duration>(
+					std::chrono::seconds(fileStat.st_mtim.tv_sec) + std::chrono::nanoseconds(fileStat.st_mtim.tv_nsec))) != entry.lastModified) {
+		close(fd);
+		return nullptr;
+	}
+
+	void* data = mmap(nullptr, static_cast<std::size_t>(fileStat.st_size), PROT_READ, MAP_SHARED, fd, 0);
+	close(fd);
+
+	if(data == MAP_FAILED) {
+		logger.debug << "Could not map file \"" << path << "\" (" << std::strerror(errno) << ").\n";
+		return nullptr;
+	}
+
+	return std::make_shared<const Mapping>(data, static_cast<std::size_t>(fileStat.st_size));
+}
+
+std::uint64_t MappedFileCache::getHits() const noexcept {
+	return hits.load(std::memory_order_relaxed);
+}
+
+std::uint64_t MappedFileCache::getMisses() const noexcept {
+	return misses.load(std::memory_order_relaxed);
+}
+
+void MappedFileCache::erase(std::list<Node>::iterator nodeIter) {
+	bytes -= nodeIter->mapping->getSize();
+	nodeByPath.erase(nodeIter->path);
+	nodes.erase(nodeIter);
+}
+
+} /* namespace utility */
+} /* namespace openjerry */
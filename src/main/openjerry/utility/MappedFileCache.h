@@ -0,0 +1,103 @@
+/*
+ * This file is part of Jerry application server.
+ * Copyright (C) 2020-2022 Sven Lukas
+ *
+ * Jerry is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as
+ * published by the Free Software Foundation, either version 3 of
+ * the License, or (at your option) any later version.
+ *
+ * Jerry is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public
+ * License along with Jerry.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#ifndef OPENJERRY_UTILITY_MAPPEDFILECACHE_H_
+#define OPENJERRY_UTILITY_MAPPEDFILECACHE_H_
+
+#include <openjerry/utility/FileCache.h>
+
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <list>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+
+namespace openjerry {
+namespace utility {
+
+/* Cache of long-lived read-only memory mappings of regular files with a budget of mapped bytes
+ * and LRU eviction. A mapping is valid as long as inode, size and modification time of the file
+ * are unchanged, otherwise the file is mapped again. Mappings are reference counted, so a mapping
+ * that is replaced or evicted stays valid until the last response using it has been sent.
+ *
+ * Files have to be replaced by a new file (e.g. by rename) instead of being truncated in place,
+ * because reading a truncated part of a mapping terminates the process with SIGBUS.
+ */
+class MappedFileCache {
+public:
+	class Mapping {
+	public:
+		Mapping(const void* data, std::size_t size);
+		Mapping(const Mapping&) = delete;
+		~Mapping();
+
+		Mapping& operator=(const Mapping&) = delete;
+
+		const char* getData() const noexcept;
+		std::size_t getSize() const noexcept;
+
+	private:
+		const void* data;
+		std::size_t size;
+	};
+
+	/* 'maxBytes' is the budget of all mappings, 'maxFileSize' the maximum size of a mapped file */
+	MappedFileCache(std::size_t maxBytes, std::size_t maxFileSize);
+
+	/* returns nullptr if the file is empty, too large, cannot be mapped or does not match 'entry' anymore */
+	std::shared_ptr<const Mapping> get(const std::string& path, const FileCache::Entry& entry);
+
+	/* maps the regular file 'path' if it still matches 'entry', otherwise nullptr is returned */
+	static std::shared_ptr<const Mapping> map(const std::string& path, const FileCache::Entry& entry);
+
+	std::uint64_t getHits() const noexcept;
+	std::uint64_t getMisses() const noexcept;
+
+private:
+	struct Node {
+		std::string path;
+		std::uint64_t inode;
+		std::uint64_t size;
+		std::chrono::system_clock::time_point lastModified;
+		std::shared_ptr<const Mapping> mapping;
+	};
+
+	const std::size_t maxBytes;
+	const std::size_t maxFileSize;
+
+	std::mutex mutex;
+
+	/* most recently used node is at front */
+	std::list<Node> nodes;
+	std::unordered_map<std::string, std::list<Node>::iterator> nodeByPath;
+	std::size_t bytes = 0;
+
+	std::atomic<std::uint64_t> hits{0};
+	std::atomic<std::uint64_t> misses{0};
+
+	void erase(std::list<Node>::iterator nodeIter);
+};
+
+} /* namespace utility */
+} /* namespace openjerry */
+
+#endif /* OPENJERRY_UTILITY_MAPPEDFILECACHE_H_ */
@@ -0,0 +1,50 @@
+/*
+ * This file is part of Jerry application server.
+ * Copyright (C) 2020-2022 Sven Lukas
+ *
+ * Jerry is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as
+ * published by the Free Software Foundation, either version 3 of
+ * the License, or (at your option) any later version.
+ *
+ * Jerry is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public
+ * License along with Jerry.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include <openjerry/utility/MappedProducer.h>
+
+#include <algorithm>
+
+namespace openjerry {
+namespace utility {
+
+MappedProducer::MappedProducer(std::shared_ptr<const MappedFileCache::Mapping> aMapping, std::size_t offset, std::size_t size)
+: mapping(std::move(aMapping)),
+  pos(std::min(offset, mapping->getSize())),
+  end(pos + std::min(size, mapping->getSize() - pos))
+{ }
+
+esl::io::Output MappedProducer::create(std::shared_ptr<const MappedFileCache::Mapping> mapping, std::size_t offset, std::size_t size) {
+	return esl::io::Output(std::unique_ptr<esl::io::Producer>(new MappedProducer(std::move(mapping), offset, size)));
+}
+
+std::size_t MappedProducer::produce(esl::io::Writer& writer) {
+	if(pos >= end) {
+		return esl::io::Writer::npos;
+	}
+
+	std::size_t count = writer.write(mapping->getData() + pos, end - pos);
+	if(count != esl::io::Writer::npos) {
+		pos += count;
+	}
+
+	return count;
+}
+
+} /* namespace utility */
+} /* namespace openjerry */
@@ -0,0 +1,55 @@
+/*
+ * This file is part of Jerry application server.
+ * Copyright (C) 2020-2022 Sven Lukas
+ *
+ * Jerry is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as
+ * published by the Free Software Foundation, either version 3 of
+ * the License, or (at your option) any later version.
+ *
+ * Jerry is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public
+ * License along with Jerry.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#ifndef OPENJERRY_UTILITY_MAPPEDPRODUCER_H_
+#define OPENJERRY_UTILITY_MAPPEDPRODUCER_H_
+
+#include <openjerry/utility/MappedFileCache.h>
+
+#include <esl/io/Output.h>
+#include <esl/io/Producer.h>
+#include <esl/io/Writer.h>
+
+#include <cstddef>
+#include <memory>
+#include <string>
+
+namespace openjerry {
+namespace utility {
+
+/* Producer for a part of a shared memory mapping. It keeps the mapping alive until the output
+ * has been sent, even if the mapping has been removed from a cache in the meantime.
+ */
+class MappedProducer : public esl::io::Producer {
+public:
+	MappedProducer(std::shared_ptr<const MappedFileCache::Mapping> mapping, std::size_t offset = 0, std::size_t size = std::string::npos);
+
+	static esl::io::Output create(std::shared_ptr<const MappedFileCache::Mapping> mapping, std::size_t offset = 0, std::size_t size = std::string::npos);
+
+	std::size_t produce(esl::io::Writer& writer) override;
+
+private:
+	std::shared_ptr<const MappedFileCache::Mapping> mapping;
+	std::size_t pos;
+	std::size_t end;
+};
+
+} /* namespace utility */
+} /* namespace openjerry */
+
+#endif /* OPENJERRY_UTILITY_MAPPEDPRODUCER_H_ */
@@ -0,0 +1,39 @@
+/*
+ * This file is part of Jerry application server.
+ * Copyright (C) 2020-2022 Sven Lukas
+ *
+ * Jerry is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as
+ * published by the Free Software Foundation, either version 3 of
+ * the License, or (at your option) any later version.
+ *
+ * Jerry is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public
+ * License along with Jerry.  If not, see <https://www.gnu.org/licenses/>.
+ */
+#include <openjerry/utility/Number.h>
+
+#include <stdexcept>
+
+namespace openjerry {
+namespace utility {
+
+std::size_t Number::toNumber(const std::string& key, const std::string& value) {
+	/* std::stoul skips leading white space and accepts a sign */
+	std::string::size_type pos = value.find_first_not_of(" \t\r\n");
+	if(pos != std::string::npos && value[pos] != '-') {
+		try {
+			return std::stoul(value);
+		}
+		catch(...) {
+		}
+	}
+	throw std::runtime_error("Invalid value \"" + value + "\" for parameter key=\"" + key + "\". Value must be a non-negative integer");
+}
+
+} /* namespace utility */
+} /* namespace openjerry */
@@ -0,0 +1,39 @@
+/*
+ * This file is part of Jerry application server.
+ * Copyright (C) 2020-2022 Sven Lukas
+ *
+ * Jerry is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as
+ * published by the Free Software Foundation, either version 3 of
+ * the License, or (at your option) any later version.
+ *
+ * Jerry is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public
+ * License along with Jerry.  If not, see <https://www.gnu.org/licenses/>.
+ */
+#ifndef OPENJERRY_UTILITY_NUMBER_H_
+#define OPENJERRY_UTILITY_NUMBER_H_
+
+#include <cstddef>
+#include <string>
+
+namespace openjerry {
+namespace utility {
+
+struct Number final {
+	Number() = delete;
+
+	/* Parses the value of parameter 'key' as non-negative integer. Unlike std::stoul a negative value
+	 * is rejected instead of wrapping around to a huge number. Throws std::runtime_error if it is invalid.
+	 */
+	static std::size_t toNumber(const std::string& key, const std::string& value);
+};
+
+} /* namespace utility */
+} /* namespace openjerry */
+
+#endif /* OPENJERRY_UTILITY_NUMBER_H_ */
@@ -0,0 +1,143 @@
+/*
+ * This file is part of Jerry application server.
+ * Copyright (C) 2020-2022 Sven Lukas
+ *
+ * Jerry is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as
+ * published by the Free Software Foundation, either version 3 of
+ * the License, or (at your option) any later version.
+ *
+ * Jerry is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public
+ * License along with Jerry.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include <openjerry/utility/RangeProducer.h>
+#include <openjerry/Logger.h>
+
+#include <algorithm>
+
+#include <errno.h>
+#include <fcntl.h>
+#include <unistd.h>
+
+namespace openjerry {
+namespace utility {
+
+namespace {
+Logger logger("openjerry::utility::RangeProducer");
+
+constexpr std::size_t bufferSize = 64 * 1024;
+} /* anonymous namespace */
+
+RangeProducer::RangeProducer(std::string aPath)
+: path(std::move(aPath))
+{ }
+
+RangeProducer::RangeProducer(std::string aPath, std::shared_ptr<const std::string> content)
+: path(std::move(aPath))
+{
+	if(content) {
+		contentData = content->data();
+		contentSize = content->size();
+		contentOwner = std::move(content);
+	}
+}
+
+RangeProducer::RangeProducer(std::string aPath, std::shared_ptr<const MappedFileCache::Mapping> mapping)
+: path(std::move(aPath))
+{
+	if(mapping) {
+		contentData = mapping->getData();
+		contentSize = mapping->getSize();
+		contentOwner = std::move(mapping);
+	}
+}
+
+RangeProducer::~RangeProducer() {
+	if(fd >= 0) {
+		::close(fd);
+	}
+}
+
+void RangeProducer::addText(std::string text) {
+	std::shared_ptr<const std::string> textPtr = std::make_shared<const std::string>(std::move(text));
+	const char* data = textPtr->data();
+	std::size_t size = textPtr->size();
+	parts.push_back(Part{std::move(textPtr), data, 0, size});
+}
+
+void RangeProducer::addRange(std::size_t offset, std::size_t size) {
+	if(contentOwner) {
+		offset = std::min(offset, contentSize);
+		size = std::min(size, contentSize - offset);
+		parts.push_back(Part{contentOwner, contentData, offset, size});
+	}
+	else {
+		parts.push_back(Part{nullptr, nullptr, offset, size});
+	}
+}
+
+esl::io::Output RangeProducer::create(std::unique_ptr<RangeProducer> rangeProducer) {
+	return esl::io::Output(std::unique_ptr<esl::io::Producer>(rangeProducer.release()));
+}
+
+std::size_t RangeProducer::produce(esl::io::Writer& writer) {
+	while(currentPart < parts.size() && currentPos >= parts[currentPart].size) {
+		++currentPart;
+		currentPos = 0;
+	}
+	if(currentPart >= parts.size()) {
+		return esl::io::Writer::npos;
+	}
+
+	const Part& part = parts[currentPart];
+
+	if(part.data) {
+		std::size_t count = writer.write(part.data + part.offset + currentPos, part.size - currentPos);
+		if(count != esl::io::Writer::npos) {
+			currentPos += count;
+		}
+		return count;
+	}
+
+	if(bufferPos >= bufferEnd) {
+		if(fd < 0) {
+			fd = ::open(path.c_str(), O_RDONLY | O_CLOEXEC);
+			if(fd < 0) {
+				logger.warn << "Cannot open file \"" << path << "\" to send a range of it.\n";
+				return esl::io::Writer::npos;
+			}
+			buffer.resize(bufferSize);
+		}
+
+		std::size_t readSize = std::min(buffer.size(), part.size - currentPos);
+		ssize_t rc;
+		do {
+			rc = ::pread(fd, buffer.data(), readSize, static_cast<off_t>(part.offset + currentPos));
+		} while(rc < 0 && errno == EINTR);
+
+		if(rc <= 0) {
+			/* file has been truncated or cannot be read anymore */
+			logger.warn << "Cannot read range of file \"" << path << "\".\n";
+			return esl::io::Writer::npos;
+		}
+		bufferPos = 0;
+		bufferEnd = static_cast<std::size_t>(rc);
+	}
+
+	std::size_t count = writer.write(buffer.data() + bufferPos, bufferEnd - bufferPos);
+	if(count != esl::io::Writer::npos) {
+		bufferPos += count;
+		currentPos += count;
+	}
+
+	return count;
+}
+
+} /* namespace utility */
+} /* namespace openjerry */
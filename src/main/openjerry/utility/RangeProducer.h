@@ -0,0 +1,84 @@
+/*
+ * This file is part of Jerry application server.
+ * Copyright (C) 2020-2022 Sven Lukas
+ *
+ * Jerry is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as
+ * published by the Free Software Foundation, either version 3 of
+ * the License, or (at your option) any later version.
+ *
+ * Jerry is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public
+ * License along with Jerry.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#ifndef OPENJERRY_UTILITY_RANGEPRODUCER_H_
+#define OPENJERRY_UTILITY_RANGEPRODUCER_H_
+
+#include <openjerry/utility/MappedFileCache.h>
+
+#include <esl/io/Output.h>
+#include <esl/io/Producer.h>
+#include <esl/io/Writer.h>
+
+#include <cstddef>
+#include <memory>
+#include <string>
+#include <vector>
+
+namespace openjerry {
+namespace utility {
+
+/* Producer for a sequence of text parts and byte ranges of a file. Ranges are read from
+ * the shared content or mapping if it is available or streamed from the file otherwise,
+ * so a range is never buffered completely in memory.
+ */
+class RangeProducer : public esl::io::Producer {
+public:
+	explicit RangeProducer(std::string path);
+	RangeProducer(std::string path, std::shared_ptr<const std::string> content);
+	RangeProducer(std::string path, std::shared_ptr<const MappedFileCache::Mapping> mapping);
+	~RangeProducer();
+
+	void addText(std::string text);
+	void addRange(std::size_t offset, std::size_t size);
+
+	static esl::io::Output create(std::unique_ptr<RangeProducer> rangeProducer);
+
+	std::size_t produce(esl::io::Writer& writer) override;
+
+private:
+	struct Part {
+		/* owner and data of the part or nullptr if the part is read from the file */
+		std::shared_ptr<const void> owner;
+		const char* data;
+		std::size_t offset;
+		std::size_t size;
+	};
+
+	std::string path;
+
+	/* content or mapping of the file if available */
+	std::shared_ptr<const void> contentOwner;
+	const char* contentData = nullptr;
+	std::size_t contentSize = 0;
+
+	std::vector<Part> parts;
+
+	std::size_t currentPart = 0;
+	std::size_t currentPos = 0;
+
+	int fd = -1;
+	std::vector<char> buffer;
+	std::size_t bufferPos = 0;
+	std::size_t bufferEnd = 0;
+};
+
+} /* namespace utility */
+} /* namespace openjerry */
+
+#endif /* OPENJERRY_UTILITY_RANGEPRODUCER_H_ */
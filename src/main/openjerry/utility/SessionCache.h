@@ -0,0 +1,358 @@
+/*
+ * This file is part of Jerry application server.
+ * Copyright (C) 2020-2022 Sven Lukas
+ *
+ * Jerry is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as
+ * published by the Free Software Foundation, either version 3 of
+ * the License, or (at your option) any later version.
+ *
+ * Jerry is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public
+ * License along with Jerry.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#ifndef OPENJERRY_UTILITY_SESSIONCACHE_H_
+#define OPENJERRY_UTILITY_SESSIONCACHE_H_
+
+#include <openjerry/utility/FrequencySketch.h>
+#include <openjerry/utility/SessionCacheSettings.h>
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <exception>
+#include <functional>
+#include <future>
+#include <iterator>
+#include <list>
+#include <memory>
+#include <mutex>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+namespace openjerry {
+namespace utility {
+
+/* Cache of objects of type T that are expensive to create, e.g. by a database lookup. Objects expire
+ * after 'lifetime', with 'lifetimeRenew' every access starts the lifetime again. Concurrent misses of
+ * the same key are coalesced: the first caller creates the object and all other callers wait for it.
+ * Objects are shared by all callers, so they are never modified after creation.
+ *
+ * The cache is divided into shards with their own lock, capacity and memory budget. A full shard
+ * removes its least recently used object. With TinyLFU eviction a new object is only admitted if
+ * it has been requested more often recently than the object it would replace.
+ *
+ * With negative caching a key without object, i.e. 'create' returned nullptr, is cached as well,
+ * in a separate LRU list with its own capacity and lifetime. Exceptions thrown by 'create' are
+ * never cached, so temporary failures must be reported by an exception instead of nullptr.
+ */
+template <class T, class Key, class... Args>
+class SessionCache {
+public:
+	using Create = std::function<std::unique_ptr<T>(const Args&...)>;
+
+	/* returns the memory used by key and object, without the bookkeeping of the cache, object is nullptr for negative caching */
+	using Size = std::function<std::size_t(const Key&, const T*)>;
+
+	SessionCache(Create aCreate, const SessionCacheSettings& settings, std::chrono::milliseconds aLifetime, bool aLifetimeRenew, Size aSize = nullptr)
+	: create(std::move(aCreate)),
+	  size(std::move(aSize)),
+	  lifetime(aLifetime),
+	  lifetimeRenew(aLifetimeRenew),
+	  tinyLfu(settings.getEviction() == SessionCacheSettings::Eviction::tinyLfu),
+	  negativeLifetime(settings.getNegativeLifetime())
+	{
+		/* there are not more shards than entries, so every shard caches at least one object and the
+		 * capacities of all shards add up to the configured ones exactly */
+		std::size_t maxEntries = settings.getMaxEntries();
+		std::size_t maxBytes = settings.getMaxBytes();
+		std::size_t maxNegativeEntries = settings.getMaxNegativeEntries();
+		std::size_t shardCount = std::min(settings.getShards(), maxEntries > 0 ? maxEntries : maxNegativeEntries);
+		if(shardCount == 0) {
+			shardCount = 1;
+		}
+
+		for(std::size_t i = 0; i < shardCount; ++i) {
+			/* a budget of 0 bytes means unlimited, so every shard gets at least 1 byte of a configured budget */
+			std::size_t shardMaxBytes = maxBytes / shardCount + (i < maxBytes % shardCount ? 1 : 0);
+			if(maxBytes > 0 && shardMaxBytes == 0) {
+				shardMaxBytes = 1;
+			}
+			shards.emplace_back(new Shard(maxEntries / shardCount + (i < maxEntries % shardCount ? 1 : 0),
+					shardMaxBytes,
+					maxNegativeEntries / shardCount + (i < maxNegativeEntries % shardCount ? 1 : 0)));
+		}
+	}
+
+	/* returns the object of 'key' or creates it with 'args', nullptr is cached only with negative caching */
+	std::shared_ptr<const T> get(const Key& key, const Args&... args) {
+		std::uint64_t hash = getHash(key);
+		Shard& shard = *shards[hash % shards.size()];
+
+		std::promise<std::shared_ptr<const T>> promise;
+		{
+			std::unique_lock<std::mutex> lock(shard.mutex);
+			std::chrono::steady_clock::time_point now = std::chrono::steady_clock::now();
+
+			if(tinyLfu) {
+				shard.sketch.increment(hash);
+			}
+
+			auto nodeIter = shard.nodeByKey.find(key);
+			if(nodeIter != shard.nodeByKey.end()) {
+				Node& node = *nodeIter->second;
+				if(node.negative && now < node.expiresAt) {
+					negativeHits.fetch_add(1, std::memory_order_relaxed);
+					shard.negativeNodes.splice(shard.negativeNodes.begin(), shard.negativeNodes, nodeIter->second);
+					return nullptr;
+				}
+				if(!node.negative && now < node.expiresAt) {
+					hits.fetch_add(1, std::memory_order_relaxed);
+					if(lifetimeRenew) {
+						node.expiresAt = now + lifetime;
+					}
+					shard.nodes.splice(shard.nodes.begin(), shard.nodes, nodeIter->second);
+					return node.object;
+				}
+				shard.remove(nodeIter->second);
+			}
+
+			auto pendingIter = shard.pending.find(key);
+			if(pendingIter != shard.pending.end()) {
+				coalesced.fetch_add(1, std::memory_order_relaxed);
+				std::shared_future<std::shared_ptr<const T>> future = pendingIter->second;
+				lock.unlock();
+				return future.get();
+			}
+
+			misses.fetch_add(1, std::memory_order_relaxed);
+			shard.pending.insert(std::make_pair(key, promise.get_future().share()));
+		}
+
+		/* the pending miss must be removed and waiting callers must be woken up on any exception,
+		 * also if inserting throws, otherwise all later callers of 'key' would wait forever */
+		std::shared_ptr<const T> object;
+		try {
+			object = create(args...);
+
+			std::lock_guard<std::mutex> lock(shard.mutex);
+			shard.pending.erase(key);
+			if(object) {
+				insert(shard, key, hash, object);
+			}
+			else {
+				insertNegative(shard, key, hash);
+			}
+		}
+		catch(...) {
+			{
+				std::lock_guard<std::mutex> lock(shard.mutex);
+				shard.pending.erase(key);
+			}
+			promise.set_exception(std::current_exception());
+			throw;
+		}
+		promise.set_value(object);
+
+		return object;
+	}
+
+	std::uint64_t getHits() const noexcept {
+		return hits.load(std::memory_order_relaxed);
+	}
+
+	std::uint64_t getMisses() const noexcept {
+		return misses.load(std::memory_order_relaxed);
+	}
+
+	/* number of misses that waited for the object created by a concurrent miss */
+	std::uint64_t getCoalesced() const noexcept {
+		return coalesced.load(std::memory_order_relaxed);
+	}
+
+	/* number of objects removed to make room for a new object */
+	std::uint64_t getEvictions() const noexcept {
+		return evictions.load(std::memory_order_relaxed);
+	}
+
+	/* number of new objects not cached, because of TinyLFU admission or because they exceed the memory budget */
+	std::uint64_t getRejections() const noexcept {
+		return rejections.load(std::memory_order_relaxed);
+	}
+
+	/* number of lookups answered by a cached key without object */
+	std::uint64_t getNegativeHits() const noexcept {
+		return negativeHits.load(std::memory_order_relaxed);
+	}
+
+	std::size_t getEntries() {
+		std::size_t entries = 0;
+		for(auto& shard : shards) {
+			std::lock_guard<std::mutex> lock(shard->mutex);
+			entries += shard->nodes.size();
+		}
+		return entries;
+	}
+
+	std::size_t getNegativeEntries() {
+		std::size_t entries = 0;
+		for(auto& shard : shards) {
+			std::lock_guard<std::mutex> lock(shard->mutex);
+			entries += shard->negativeNodes.size();
+		}
+		return entries;
+	}
+
+	/* estimated memory of all cached objects and keys without object in bytes */
+	std::size_t getBytes() {
+		std::size_t bytes = 0;
+		for(auto& shard : shards) {
+			std::lock_guard<std::mutex> lock(shard->mutex);
+			bytes += shard->bytes + shard->negativeBytes;
+		}
+		return bytes;
+	}
+
+private:
+	struct Node {
+		Key key;
+		std::uint64_t hash;
+		bool negative;
+		std::size_t bytes;
+		std::shared_ptr<const T> object;
+		std::chrono::steady_clock::time_point expiresAt;
+	};
+
+	using NodeList = std::list<Node>;
+	using NodeByKey = std::unordered_map<Key, typename NodeList::iterator>;
+
+	struct Shard {
+		Shard(std::size_t aMaxEntries, std::size_t aMaxBytes, std::size_t aMaxNegativeEntries)
+		: maxEntries(aMaxEntries),
+		  maxBytes(aMaxBytes),
+		  maxNegativeEntries(aMaxNegativeEntries),
+		  sketch(aMaxEntries)
+		{ }
+
+		void remove(typename NodeList::iterator nodeIter) {
+			if(nodeIter->negative) {
+				negativeBytes -= nodeIter->bytes;
+				nodeByKey.erase(nodeIter->key);
+				negativeNodes.erase(nodeIter);
+			}
+			else {
+				bytes -= nodeIter->bytes;
+				nodeByKey.erase(nodeIter->key);
+				nodes.erase(nodeIter);
+			}
+		}
+
+		const std::size_t maxEntries;
+		/* 0 means unlimited */
+		const std::size_t maxBytes;
+		const std::size_t maxNegativeEntries;
+
+		std::mutex mutex;
+
+		/* most recently used node is at front */
+		NodeList nodes;
+		/* keys without object, most recently used node is at front */
+		NodeList negativeNodes;
+		/* nodes of both lists */
+		NodeByKey nodeByKey;
+		std::unordered_map<Key, std::shared_future<std::shared_ptr<const T>>> pending;
+		std::size_t bytes = 0;
+		std::size_t negativeBytes = 0;
+		FrequencySketch sketch;
+	};
+
+	const Create create;
+	const Size size;
+	const std::chrono::milliseconds lifetime;
+	const bool lifetimeRenew;
+	const bool tinyLfu;
+	const std::chrono::milliseconds negativeLifetime;
+	std::vector<std::unique_ptr<Shard>> shards;
+
+	std::atomic<std::uint64_t> hits{0};
+	std::atomic<std::uint64_t> misses{0};
+	std::atomic<std::uint64_t> coalesced{0};
+	std::atomic<std::uint64_t> evictions{0};
+	std::atomic<std::uint64_t> rejections{0};
+	std::atomic<std::uint64_t> negativeHits{0};
+
+	void insert(Shard& shard, const Key& key, std::uint64_t hash, const std::shared_ptr<const T>& object) {
+		if(shard.maxEntries == 0) {
+			return;
+		}
+
+		/* list node, hash table node and the control block of the shared object are counted as well */
+		std::size_t bytes = sizeof(Node) + sizeof(typename NodeByKey::value_type) + 4 * sizeof(void*)
+				+ (size ? size(key, object.get()) : sizeof(Key) + sizeof(T));
+		if(shard.maxBytes > 0 && bytes > shard.maxBytes) {
+			rejections.fetch_add(1, std::memory_order_relaxed);
+			return;
+		}
+
+		auto isFull = [&]() {
+			return shard.nodes.size() >= shard.maxEntries || (shard.maxBytes > 0 && shard.bytes + bytes > shard.maxBytes);
+		};
+
+		/* an object requested rarely must not replace an object that is requested more often */
+		if(tinyLfu && isFull() && shard.sketch.estimate(hash) <= shard.sketch.estimate(shard.nodes.back().hash)
+				&& std::chrono::steady_clock::now() < shard.nodes.back().expiresAt) {
+			rejections.fetch_add(1, std::memory_order_relaxed);
+			return;
+		}
+
+		while(!shard.nodes.empty() && isFull()) {
+			shard.remove(std::prev(shard.nodes.end()));
+			evictions.fetch_add(1, std::memory_order_relaxed);
+		}
+
+		shard.nodes.push_front(Node{key, hash, false, bytes, object, std::chrono::steady_clock::now() + lifetime});
+		shard.nodeByKey[key] = shard.nodes.begin();
+		shard.bytes += bytes;
+	}
+
+	void insertNegative(Shard& shard, const Key& key, std::uint64_t hash) {
+		if(shard.maxNegativeEntries == 0) {
+			return;
+		}
+
+		std::size_t bytes = sizeof(Node) + sizeof(typename NodeByKey::value_type) + 2 * sizeof(void*)
+				+ (size ? size(key, nullptr) : sizeof(Key));
+
+		while(shard.negativeNodes.size() >= shard.maxNegativeEntries) {
+			shard.remove(std::prev(shard.negativeNodes.end()));
+		}
+
+		shard.negativeNodes.push_front(Node{key, hash, true, bytes, nullptr, std::chrono::steady_clock::now() + negativeLifetime});
+		shard.nodeByKey[key] = shard.negativeNodes.begin();
+		shard.negativeBytes += bytes;
+	}
+
+	static std::uint64_t getHash(const Key& key) {
+		/* std::hash may be the identity, so the bits are mixed for shard and sketch */
+		std::uint64_t hash = std::hash<Key>()(key);
+		hash ^= hash >> 33;
+		hash *= 0xff51afd7ed558ccdULL;
+		hash ^= hash >> 33;
+		hash *= 0xc4ceb9fe1a85ec53ULL;
+		hash ^= hash >> 33;
+		return hash;
+	}
+};
+
+} /* namespace utility */
+} /* namespace openjerry */
+
+#endif /* OPENJERRY_UTILITY_SESSIONCACHE_H_ */
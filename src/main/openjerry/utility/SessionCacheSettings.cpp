@@ -0,0 +1,116 @@
+/*
+ * This file is part of Jerry application server.
+ * Copyright (C) 2020-2022 Sven Lukas
+ *
+ * Jerry is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as
+ * published by the Free Software Foundation, either version 3 of
+ * the License, or (at your option) any later version.
+ *
+ * Jerry is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public
+ * License along with Jerry.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include <openjerry/utility/SessionCacheSettings.h>
+#include <openjerry/utility/Number.h>
+
+#include <stdexcept>
+
+namespace openjerry {
+namespace utility {
+
+bool SessionCacheSettings::addSetting(const std::string& key, const std::string& value) {
+	if(key == "cache-size") {
+		if(hasMaxEntries) {
+			throw std::runtime_error("Multiple definition of attribute 'cache-size'");
+		}
+		hasMaxEntries = true;
+		maxEntries = Number::toNumber(key, value);
+	}
+	else if(key == "cache-max-bytes") {
+		if(hasMaxBytes) {
+			throw std::runtime_error("Multiple definition of attribute 'cache-max-bytes'");
+		}
+		hasMaxBytes = true;
+		maxBytes = Number::toNumber(key, value);
+	}
+	else if(key == "cache-shards") {
+		if(hasShards) {
+			throw std::runtime_error("Multiple definition of attribute 'cache-shards'");
+		}
+		hasShards = true;
+		shards = Number::toNumber(key, value);
+		if(shards == 0) {
+			throw std::runtime_error("Value \"0\" of parameter 'cache-shards' is invalid");
+		}
+	}
+	else if(key == "cache-eviction") {
+		if(hasEviction) {
+			throw std::runtime_error("Multiple definition of attribute 'cache-eviction'");
+		}
+		hasEviction = true;
+		if(value == "lru") {
+			eviction = Eviction::lru;
+		}
+		else if(value == "tinylfu") {
+			eviction = Eviction::tinyLfu;
+		}
+		else {
+			throw std::runtime_error("Unknown value \"" + value + "\" for parameter key=\"cache-eviction\". Possible values are \"lru\" or \"tinylfu\".");
+		}
+	}
+	else if(key == "negative-cache-size") {
+		if(hasMaxNegativeEntries) {
+			throw std::runtime_error("Multiple definition of attribute 'negative-cache-size'");
+		}
+		hasMaxNegativeEntries = true;
+		maxNegativeEntries = Number::toNumber(key, value);
+	}
+	else if(key == "negative-lifetime-ms") {
+		if(hasNegativeLifetime) {
+			throw std::runtime_error("Multiple definition of attribute 'negative-lifetime-ms'");
+		}
+		hasNegativeLifetime = true;
+		negativeLifetime = std::chrono::milliseconds(Number::toNumber(key, value));
+		if(negativeLifetime == std::chrono::milliseconds(0)) {
+			throw std::runtime_error("Value \"0\" of parameter 'negative-lifetime-ms' is invalid");
+		}
+	}
+	else {
+		return false;
+	}
+
+	return true;
+}
+
+std::size_t SessionCacheSettings::getMaxEntries() const noexcept {
+	return maxEntries;
+}
+
+std::size_t SessionCacheSettings::getMaxBytes() const noexcept {
+	return maxBytes;
+}
+
+std::size_t SessionCacheSettings::getShards() const noexcept {
+	return shards;
+}
+
+SessionCacheSettings::Eviction SessionCacheSettings::getEviction() const noexcept {
+	return eviction;
+}
+
+std::size_t SessionCacheSettings::getMaxNegativeEntries() const noexcept {
+	return maxNegativeEntries;
+}
+
+std::chrono::milliseconds SessionCacheSettings::getNegativeLifetime() const noexcept {
+	return negativeLifetime;
+}
+
+} /* namespace utility */
+} /* namespace openjerry */
@@ -0,0 +1,76 @@
+/*
+ * This file is part of Jerry application server.
+ * Copyright (C) 2020-2022 Sven Lukas
+ *
+ * Jerry is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as
+ * published by the Free Software Foundation, either version 3 of
+ * the License, or (at your option) any later version.
+ *
+ * Jerry is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public
+ * License along with Jerry.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#ifndef OPENJERRY_UTILITY_SESSIONCACHESETTINGS_H_
+#define OPENJERRY_UTILITY_SESSIONCACHESETTINGS_H_
+
+#include <chrono>
+#include <cstddef>
+#include <string>
+
+namespace openjerry {
+namespace utility {
+
+/* Parameters 'cache-size', 'cache-max-bytes', 'cache-shards', 'cache-eviction', 'negative-cache-size'
+ * and 'negative-lifetime-ms' of procedures using a SessionCache
+ */
+class SessionCacheSettings {
+public:
+	enum class Eviction {
+		lru,
+		tinyLfu
+	};
+
+	/* returns false if 'key' is not a parameter of the session cache */
+	bool addSetting(const std::string& key, const std::string& value);
+
+	/* maximum number of cached objects */
+	std::size_t getMaxEntries() const noexcept;
+
+	/* maximum memory of cached objects in bytes, 0 means unlimited */
+	std::size_t getMaxBytes() const noexcept;
+
+	/* number of shards with their own lock, capacity and memory budget */
+	std::size_t getShards() const noexcept;
+
+	Eviction getEviction() const noexcept;
+
+	/* maximum number of cached keys without object, 0 disables negative caching */
+	std::size_t getMaxNegativeEntries() const noexcept;
+
+	std::chrono::milliseconds getNegativeLifetime() const noexcept;
+
+private:
+	std::size_t maxEntries = 10;
+	bool hasMaxEntries = false;
+	std::size_t maxBytes = 0;
+	bool hasMaxBytes = false;
+	std::size_t shards = 16;
+	bool hasShards = false;
+	Eviction eviction = Eviction::lru;
+	bool hasEviction = false;
+	std::size_t maxNegativeEntries = 0;
+	bool hasMaxNegativeEntries = false;
+	std::chrono::milliseconds negativeLifetime = std::chrono::milliseconds(5000);
+	bool hasNegativeLifetime = false;
+};
+
+} /* namespace utility */
+} /* namespace openjerry */
+
+#endif /* OPENJERRY_UTILITY_SESSIONCACHESETTINGS_H_ */